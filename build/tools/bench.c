@@ -0,0 +1,410 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "api.h"
+#include "cart.h"
+#include "tools.h"
+#include "script.h"
+#include "studio/project.h"
+#include "ext/thread.h"
+#include "version.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#endif
+
+#if defined(TIC_MODULE_EXT)
+#include <dlfcn.h>
+#endif
+
+#define DEFAULT_ITERATIONS 200
+#define DEFAULT_FRAMES 600
+
+typedef struct
+{
+    const char* name;
+    void(*setup)(tic_mem* tic);
+    void(*run)(tic_mem* tic);
+} Bench;
+
+typedef struct
+{
+    u64* data;
+    s32 count;
+} Samples;
+
+static struct
+{
+    s32 iterations;
+    s32 frames;
+    bool first;
+    tic_cartridge cart;
+    u8* buffer;
+    s32 size;
+} state =
+{
+    .iterations = DEFAULT_ITERATIONS,
+    .frames = DEFAULT_FRAMES,
+    .first = true,
+};
+
+static u64 getCounter(void* data)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u64)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static u64 getFreq(void* data)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER freq;
+    QueryPerformanceFrequency(&freq);
+    return freq.QuadPart;
+#else
+    return 1000000000;
+#endif
+}
+
+static s32 compareSamples(const void* a, const void* b)
+{
+    u64 x = *(const u64*)a, y = *(const u64*)b;
+    return x < y ? -1 : x > y;
+}
+
+static double percentile(const Samples* samples, s32 p)
+{
+    s32 index = (s32)((samples->count - 1) * (s64)p / 100);
+    return samples->data[index] * 1000000.0 / getFreq(NULL);
+}
+
+static void report(const char* name, Samples* samples)
+{
+    if(samples->count == 0)
+        return;
+
+    qsort(samples->data, samples->count, sizeof samples->data[0], compareSamples);
+
+    printf("%s\n    {\"name\": \"%s\", \"iterations\": %i, "
+        "\"min_us\": %.3f, \"median_us\": %.3f, \"p90_us\": %.3f, \"p99_us\": %.3f, \"max_us\": %.3f}",
+        state.first ? "" : ",", name, samples->count,
+        percentile(samples, 0), percentile(samples, 50), percentile(samples, 90),
+        percentile(samples, 99), percentile(samples, 100));
+
+    state.first = false;
+}
+
+static void setupScreen(tic_mem* tic)
+{
+    srand(0);
+
+    for(s32 i = 0; i < sizeof tic->ram->vram.screen; i++)
+        tic->ram->vram.screen.data[i] = rand();
+
+    for(s32 i = 0; i < sizeof tic->ram->tiles * TIC_SPRITE_BANKS; i++)
+        ((u8*)&tic->ram->tiles)[i] = rand();
+
+    for(s32 i = 0; i < sizeof tic->ram->map; i++)
+        tic->ram->map.data[i] = rand();
+}
+
+static void setupThreads(tic_mem* tic)
+{
+    setupScreen(tic);
+    tic_core_blit_threads(tic, tic_thread_count() - 1);
+}
+
+static void runBlit(tic_mem* tic)
+{
+    tic_core_blit(tic);
+}
+
+static void runSpr(tic_mem* tic)
+{
+    for(s32 i = 0; i < 1000; i++)
+        tic_api_spr(tic, i % TIC_BANK_SPRITES, i * 7 % TIC80_WIDTH - 4, i * 13 % TIC80_HEIGHT - 4, 1, 1,
+            (u8[]){0}, 1, 1 + i % 2, i % 4, i % 4);
+}
+
+static void runMap(tic_mem* tic)
+{
+    tic_api_map(tic, 0, 0, TIC_MAP_SCREEN_WIDTH + 1, TIC_MAP_SCREEN_HEIGHT + 1, 0, 0, (u8[]){0}, 1, 1, NULL, NULL);
+}
+
+static void runTtri(tic_mem* tic)
+{
+    for(s32 i = 0; i < 100; i++)
+    {
+        float x = (float)(i * 7 % TIC80_WIDTH), y = (float)(i * 13 % TIC80_HEIGHT);
+        tic_api_ttri(tic, x, y, x + 64, y, x, y + 64, 0, 0, 64, 0, 0, 64,
+            tic_tiles_texture, (u8[]){0}, 1, 0, 0, 0, false);
+    }
+}
+
+static void runPrint(tic_mem* tic)
+{
+    for(s32 y = 0; y < TIC80_HEIGHT; y += TIC_FONT_HEIGHT)
+        tic_api_print(tic, "The quick brown fox jumps over the lazy dog 0123456789", 0, y, 12, false, 1, false);
+}
+
+static void runPaint(tic_mem* tic)
+{
+    tic_api_cls(tic, 0);
+    tic_api_circb(tic, TIC80_WIDTH / 2, TIC80_HEIGHT / 2, TIC80_HEIGHT / 2 - 1, 1);
+    tic_api_paint(tic, 0, 0, 2, 255);
+    tic_api_paint(tic, TIC80_WIDTH / 2, TIC80_HEIGHT / 2, 3, 255);
+}
+
+static void setupSound(tic_mem* tic)
+{
+    tic_api_reset(tic);
+    memcpy(&tic->ram->sfx, &state.cart.bank0.sfx, sizeof(tic_sfx));
+
+    for(s32 i = 0; i < TIC_SOUND_CHANNELS; i++)
+        tic_api_sfx(tic, i, 4 * 12 + i, 4, -1, i, MAX_VOLUME, MAX_VOLUME, SFX_DEF_SPEED);
+}
+
+static void runSound(tic_mem* tic)
+{
+    tic_core_tick_start(tic);
+    tic_core_tick_end(tic);
+    tic_core_synth_sound(tic);
+}
+
+static void runCartLoad(tic_mem* tic)
+{
+    tic_cart_load(&tic->cart, state.buffer, state.size);
+}
+
+static void runCartSave(tic_mem* tic)
+{
+    tic_cart_save(&state.cart, state.buffer);
+}
+
+static void runProjectLoad(tic_mem* tic)
+{
+    tic_project_load("bench.lua", (const char*)state.buffer, state.size, &tic->cart);
+}
+
+static void setupCart(tic_mem* tic)
+{
+    state.size = tic_cart_save(&state.cart, state.buffer);
+}
+
+static void setupProject(tic_mem* tic)
+{
+    state.size = tic_project_save("bench.lua", state.buffer, &state.cart);
+}
+
+static void runMicro(tic_mem* tic, const Bench* bench)
+{
+    Samples samples = {malloc(state.iterations * sizeof(u64)), 0};
+
+    if(bench->setup)
+        bench->setup(tic);
+
+    for(s32 i = 0; i < state.iterations; i++)
+    {
+        u64 start = getCounter(NULL);
+        bench->run(tic);
+        samples.data[samples.count++] = getCounter(NULL) - start;
+    }
+
+    report(bench->name, &samples);
+    free(samples.data);
+
+    tic_core_blit_threads(tic, 0);
+}
+
+static void onTrace(void* data, const char* text, u8 color) {}
+static void onExit(void* data) {}
+
+static void onError(void* data, const char* info)
+{
+    bool* failed = data;
+    *failed = true;
+    fprintf(stderr, "error: %s\n", info);
+}
+
+static bool loadDemo(const struct tic_demo* demo, tic_cartridge* cart)
+{
+    u8* data = malloc(sizeof(tic_cartridge));
+    s32 size = tic_tool_unzip(data, sizeof(tic_cartridge), demo->data, demo->size);
+
+    if(size)
+        tic_cart_load(cart, data, size);
+
+    free(data);
+    return size > 0;
+}
+
+static void runDemo(tic_mem* tic, const char* lang, const struct tic_demo* demo)
+{
+    if(!demo->data || !loadDemo(demo, &tic->cart))
+        return;
+
+    bool failed = false;
+    tic_tick_data data =
+    {
+        .error = onError,
+        .trace = onTrace,
+        .exit = onExit,
+        .data = &failed,
+        .counter = getCounter,
+        .freq = getFreq,
+    };
+
+    Samples boot = {malloc(sizeof(u64)), 0};
+    Samples frames = {malloc(state.frames * sizeof(u64)), 0};
+
+    tic_api_reset(tic);
+
+    for(s32 i = 0; i < state.frames && !failed; i++)
+    {
+        u64 start = getCounter(NULL);
+
+        tic_core_tick_start(tic);
+        tic_core_tick(tic, &data);
+        tic_core_tick_end(tic);
+        tic_core_blit(tic);
+        tic_core_synth_sound(tic);
+
+        u64 time = getCounter(NULL) - start;
+
+        if(i == 0)
+            boot.data[boot.count++] = time;
+        else
+            frames.data[frames.count++] = time;
+    }
+
+    char name[64];
+    snprintf(name, sizeof name, "demo/%s/%s/boot", lang, demo->name ? demo->name : "demo.tic");
+    report(name, &boot);
+    snprintf(name, sizeof name, "demo/%s/%s/frame", lang, demo->name ? demo->name : "demo.tic");
+    report(name, &frames);
+
+    free(boot.data);
+    free(frames.data);
+}
+
+static void loadModule(const char* path)
+{
+#if defined(TIC_MODULE_EXT)
+    void* module = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+
+    if(module)
+    {
+        const tic_script* config = dlsym(module, DEF2STR(SCRIPT_CONFIG));
+
+        if(config)
+        {
+            tic_add_script(config);
+            return;
+        }
+
+        dlclose(module);
+    }
+#endif
+
+    fprintf(stderr, "error: can't load module `%s`\n", path);
+}
+
+int main(int argc, char** argv)
+{
+    for(s32 i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+        {
+            s32 value = atoi(argv[++i]);
+            state.iterations = MAX(value, 1);
+        }
+        else if(strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            s32 value = atoi(argv[++i]);
+            state.frames = MAX(value, 2);
+        }
+        else if(argv[i][0] == '-')
+        {
+            printf("usage: tic80-bench [--iterations <n>] [--frames <n>] [script modules...]\n");
+            return 0;
+        }
+        else loadModule(argv[i]);
+    }
+
+    tic_mem* tic = tic_core_create(TIC80_SAMPLERATE, TIC80_PIXEL_COLOR_RGBA8888);
+    state.buffer = malloc(sizeof(tic_cartridge) * 3);
+
+    // canonical cart with the default palette, waveforms and some content for load/save benchmarks
+    {
+        FOREACH_LANG(script)
+            if(script->demo.data && loadDemo(&script->demo, &state.cart))
+                break;
+
+        memcpy(state.cart.bank0.tiles.data, tic->ram->tiles.data, sizeof(tic_tiles));
+        memcpy(state.cart.bank0.map.data, tic->ram->map.data, sizeof(tic_map));
+    }
+
+    static const Bench Micro[] =
+    {
+        {"core/blit",           setupScreen,    runBlit},
+        {"core/blit-mt",        setupThreads,   runBlit},
+        {"draw/spr",            setupScreen,    runSpr},
+        {"draw/map",            setupScreen,    runMap},
+        {"draw/ttri",           setupScreen,    runTtri},
+        {"draw/print",          setupScreen,    runPrint},
+        {"draw/paint",          NULL,           runPaint},
+        {"sound/synth",         setupSound,     runSound},
+        {"cart/save",           NULL,           runCartSave},
+        {"cart/load",           setupCart,      runCartLoad},
+        {"project/load",        setupProject,   runProjectLoad},
+    };
+
+    printf("{\n  \"version\": \"%i.%i.%i\",\n  \"hash\": \"%s\",\n  \"benchmarks\": [",
+        TIC_VERSION_MAJOR, TIC_VERSION_MINOR, TIC_VERSION_REVISION, TIC_VERSION_HASH);
+
+    FOR(const Bench*, bench, Micro)
+        runMicro(tic, bench);
+
+    FOREACH_LANG(script)
+    {
+        runDemo(tic, script->name, &script->demo);
+        runDemo(tic, script->name, &script->mark);
+    }
+
+    printf("\n  ]\n}\n");
+
+    free(state.buffer);
+    tic_core_close(tic);
+
+    return 0;
+}
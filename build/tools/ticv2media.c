@@ -0,0 +1,185 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// renders a native capture (.ticv) made with `tic80 --capture` or SHIFT+F9
+// to an animated GIF, a PNG sequence or a WAV file
+
+#include "capture.h"
+#include "ext/gifenc.h"
+#include "ext/png.h"
+#include "wave_writer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static s32 readCapture(void* buffer, s32 size, void* data)
+{
+    return (s32)fread(buffer, 1, size, data);
+}
+
+static bool writeGif(const void* buffer, s32 size, void* data)
+{
+    return fwrite(buffer, 1, size, data) == size;
+}
+
+static bool hasExt(const char* path, const char* ext)
+{
+    size_t len = strlen(path), extlen = strlen(ext);
+    return len >= extlen && strcmp(path + len - extlen, ext) == 0;
+}
+
+static bool exportGif(tic_capture* capture, const char* path, s32 scale)
+{
+    FILE* file = fopen(path, "wb");
+    if(!file)
+        return false;
+
+    gif_encoder* gif = gif_encoder_create(TIC80_FULLWIDTH, TIC80_FULLHEIGHT, scale, writeGif, file);
+    u32* pixels = malloc(TIC80_FULLWIDTH * TIC80_FULLHEIGHT * sizeof(u32));
+
+    // same timing as the studio recorder: every second frame, delays alternate 3/4cs
+    s32 frame = 0, time = 0;
+    for(const tic_capture_frame* data; (data = tic_capture_read(capture)); frame++)
+    {
+        if(frame % 2 == 0)
+        {
+            s32 next = (frame + 2) * 100 / TIC80_FRAMERATE;
+            tic_capture_render(data, pixels);
+            gif_encoder_frame(gif, pixels, next - time);
+            time = next;
+        }
+    }
+
+    free(pixels);
+
+    bool done = gif_encoder_close(gif);
+    return fclose(file) == 0 && done;
+}
+
+static bool exportPng(tic_capture* capture, const char* path, s32 scale)
+{
+    s32 width = TIC80_FULLWIDTH * scale;
+    s32 height = TIC80_FULLHEIGHT * scale;
+
+    u32* pixels = malloc(TIC80_FULLWIDTH * TIC80_FULLHEIGHT * sizeof(u32));
+    png_img img = {.width = width, .height = height, .pixels = malloc(width * height * sizeof(png_rgba))};
+
+    if(!pixels || !img.pixels)
+    {
+        free(img.pixels);
+        free(pixels);
+        return false;
+    }
+
+    char base[FILENAME_MAX];
+    snprintf(base, sizeof base, "%.*s", (s32)(strlen(path) - STRLEN(".png")), path);
+
+    bool done = true;
+    s32 frame = 0;
+    for(const tic_capture_frame* data; done && (data = tic_capture_read(capture)); frame++)
+    {
+        tic_capture_render(data, pixels);
+
+        for(s32 y = 0; y < height; y++)
+            for(s32 x = 0; x < width; x++)
+                img.values[y * width + x] = pixels[y / scale * TIC80_FULLWIDTH + x / scale];
+
+        png_buffer png = png_write(img, (png_buffer){NULL, 0});
+
+        char filename[FILENAME_MAX];
+        snprintf(filename, sizeof filename, "%s%05i.png", base, frame);
+
+        FILE* file = fopen(filename, "wb");
+        done = file && fwrite(png.data, 1, png.size, file) == png.size;
+        if(file) fclose(file);
+
+        free(png.data);
+    }
+
+    free(img.data);
+    free(pixels);
+
+    return done;
+}
+
+static bool exportWav(tic_capture* capture, const char* path)
+{
+    if(!wave_open(tic_capture_samplerate(capture), path))
+        return false;
+
+    wave_enable_stereo();
+
+    for(const tic_capture_frame* data; (data = tic_capture_read(capture));)
+        wave_write(data->samples, data->count);
+
+    wave_close();
+    return true;
+}
+
+s32 main(s32 argc, char** argv)
+{
+    if(argc < 3)
+    {
+        printf("usage: ticv2media <capture.ticv> <output.gif|output.png|output.wav> [scale]\n");
+        return 1;
+    }
+
+    s32 scale = argc > 3 ? atoi(argv[3]) : 1;
+    if(scale < 1)
+        scale = 1;
+
+    FILE* file = fopen(argv[1], "rb");
+    if(!file)
+    {
+        fprintf(stderr, "error: can't open `%s`\n", argv[1]);
+        return 1;
+    }
+
+    tic_capture* capture = tic_capture_open(readCapture, file);
+    if(!capture)
+    {
+        fprintf(stderr, "error: `%s` is not a TIC-80 capture\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+
+    const char* output = argv[2];
+    bool done = false;
+
+    if(hasExt(output, ".gif"))
+        done = exportGif(capture, output, scale);
+    else if(hasExt(output, ".png"))
+        done = exportPng(capture, output, scale);
+    else if(hasExt(output, ".wav"))
+        done = exportWav(capture, output);
+    else
+        fprintf(stderr, "error: unknown output format `%s`\n", output);
+
+    if(done)
+        printf("%i frames exported to `%s`\n", tic_capture_frames(capture), output);
+
+    tic_capture_close(capture);
+    fclose(file);
+
+    return done ? 0 : 1;
+}
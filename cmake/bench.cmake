@@ -0,0 +1,22 @@
+################################
+# tic80-bench
+################################
+
+if(BUILD_BENCH)
+
+    add_executable(tic80-bench
+        ${CMAKE_SOURCE_DIR}/build/tools/bench.c
+        ${CMAKE_SOURCE_DIR}/src/studio/project.c)
+
+    target_include_directories(tic80-bench PRIVATE
+        ${CMAKE_SOURCE_DIR}/src
+        ${CMAKE_SOURCE_DIR}/include
+        ${CMAKE_CURRENT_BINARY_DIR})
+
+    target_link_libraries(tic80-bench tic80core)
+
+    if(LINUX)
+        target_link_libraries(tic80-bench m dl)
+    endif()
+
+endif()
@@ -22,6 +22,9 @@ set(TIC80CORE_SRC
     ${TIC80CORE_DIR}/core/sound.c
     ${TIC80CORE_DIR}/tic.c
     ${TIC80CORE_DIR}/cart.c
+    ${TIC80CORE_DIR}/replay.c
+    ${TIC80CORE_DIR}/capture.c
+    ${TIC80CORE_DIR}/sink.c
     ${TIC80CORE_DIR}/tools.c
     ${TIC80CORE_DIR}/zip.c
     ${TIC80CORE_DIR}/tilesheet.c
@@ -29,6 +32,7 @@ set(TIC80CORE_SRC
     ${TIC80CORE_DIR}/ext/fft.c
     ${TIC80CORE_DIR}/ext/kiss_fft.c
     ${TIC80CORE_DIR}/ext/kiss_fftr.c
+    ${TIC80CORE_DIR}/ext/thread.c
 )
 
 if(BUILD_DEPRECATED)
@@ -57,6 +61,19 @@ target_include_directories(tic80core
 
 target_link_libraries(tic80core PRIVATE blipbuf)
 
+set(TIC80_FFT_SIZE 1024 CACHE STRING "FFT window size in bins")
+target_compile_definitions(tic80core PUBLIC FFT_SIZE=${TIC80_FFT_SIZE})
+
+if(NOT EMSCRIPTEN AND NOT NINTENDO_3DS AND NOT BAREMETALPI)
+    set(THREADS_PREFER_PTHREAD_FLAG ON)
+    find_package(Threads)
+
+    if(Threads_FOUND)
+        target_compile_definitions(tic80core PUBLIC TIC80_THREADS)
+        target_link_libraries(tic80core PUBLIC Threads::Threads)
+    endif()
+endif()
+
 if(BUILD_WITH_ZLIB)
     target_link_libraries(tic80core PRIVATE zlib)
 endif()
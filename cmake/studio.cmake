@@ -26,8 +26,10 @@ if(BUILD_EDITORS)
         ${TIC80LIB_DIR}/studio/editors/sfx.c
         ${TIC80LIB_DIR}/studio/editors/music.c
         ${TIC80LIB_DIR}/studio/net.c
+        ${TIC80LIB_DIR}/studio/wave.c
         ${TIC80LIB_DIR}/ext/history.c
         ${TIC80LIB_DIR}/ext/gif.c
+        ${TIC80LIB_DIR}/ext/gifenc.c
         ${TIC80LIB_DIR}/ext/png.c
     )
 endif()
@@ -1,5 +1,5 @@
 ################################
-# bin2txt cart2prj prj2cart xplode wasmp2cart
+# bin2txt cart2prj prj2cart xplode wasmp2cart ticv2media
 ################################
 
 if(BUILD_TOOLS)
@@ -33,4 +33,16 @@ if(BUILD_TOOLS)
         target_link_libraries(xplode m)
     endif()
 
+    add_executable(ticv2media
+        ${TOOLS_DIR}/ticv2media.c
+        ${CMAKE_SOURCE_DIR}/src/ext/gifenc.c
+        ${CMAKE_SOURCE_DIR}/src/ext/png.c)
+
+    target_include_directories(ticv2media PRIVATE ${CMAKE_SOURCE_DIR}/src ${CMAKE_SOURCE_DIR}/include)
+    target_link_libraries(ticv2media tic80core png wave_writer)
+
+    if(LINUX)
+        target_link_libraries(ticv2media m)
+    endif()
+
 endif()
\ No newline at end of file
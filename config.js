@@ -23,7 +23,9 @@
 "CHECK_NEW_VERSION":true,
 "SOFTWARE_RENDERING":false,
 "UI_SCALE":4,
-"TRIM_ON_SAVE":false
+"TRIM_ON_SAVE":false,
+"WATCH_INTERVAL":500,
+"DISABLE_CODE_CACHE":false
 
 }
 
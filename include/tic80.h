@@ -190,6 +190,12 @@ TIC80_API void tic80_tick(tic80* tic, tic80_input input, u64 (*counter)(), u64 (
 TIC80_API void tic80_sound(tic80* tic);
 TIC80_API void tic80_delete(tic80* tic);
 
+// deterministic input replay, see src/replay.h for the format
+TIC80_API void tic80_record(tic80* tic);
+TIC80_API void* tic80_record_end(tic80* tic, s32* size);
+TIC80_API bool tic80_replay(tic80* tic, const void* data, s32 size);
+TIC80_API bool tic80_replaying(tic80* tic);
+
 #ifdef __cplusplus
 }
 #endif
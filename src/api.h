@@ -34,6 +34,10 @@ typedef void(*ErrorOutput)(void*, const char*);
 typedef void(*ExitCallback)(void*);
 typedef u64(*CounterCallback)(void*);
 typedef u64(*FreqCallback)(void*);
+typedef s32(*TimestampCallback)(void*);
+typedef void*(*CacheLoadCallback)(void*, const char* tag, const void* code, s32 codeSize, s32* size);
+typedef void(*CacheStoreCallback)(void*, const char* tag, const void* code, s32 codeSize, const void* data, s32 size);
+typedef void(*SyncCallback)(void*, u32 mask, s32 bank);
 
 typedef struct
 {
@@ -43,8 +47,17 @@ typedef struct
 
     CounterCallback counter;
     FreqCallback freq;
+    TimestampCallback tstamp; // optional, time(NULL) is used if not set
     u64 start;
 
+    // optional compiled code cache, entries are keyed by the source and the tag (runtime name and version),
+    // cacheLoad returns a malloc'ed buffer or NULL, a runtime falls back to the source if it can't use the buffer
+    CacheLoadCallback cacheLoad;
+    CacheStoreCallback cacheStore;
+
+    // optional, called with the tic_sync_* sections sync() has written into the cart
+    SyncCallback sync;
+
     void* data;
 } tic_tick_data;
 
@@ -798,31 +811,62 @@ enum
                                                                                                                         \
                                                                                                                         \
     macro(fft,                                                                                                          \
-        "fft(start_freq end_freq=-1)",                                                                                  \
+        "fft(start_freq end_freq=-1 bands=false)",                                                                      \
                                                                                                                         \
         "Retrieves a value from 1024 buckets that map to a region of audible frequencies.\n"                            \
         "Each has value of roughly 0..1 based on the intensity of sound at that frequency at that time.\n"              \
         "If end_freq is not provided, a single value is returned for the start_freq.\n"                                 \
-        "If end_freq is provided, a sum of all values in the range is returned.",                                       \
-        2,                                                                                                              \
+        "If end_freq is provided, a sum of all values in the range is returned.\n"                                      \
+        "If bands is true, start_freq and end_freq index 32 log-frequency bands instead of the buckets.",               \
+        3,                                                                                                              \
         1,                                                                                                              \
         0,                                                                                                              \
         double,                                                                                                         \
-        tic_mem*, s32 startFreq, s32 endFreq)                                                                           \
+        tic_mem*, s32 startFreq, s32 endFreq, bool bands)                                                               \
                                                                                                                         \
                                                                                                                         \
     macro(ffts,                                                                                                         \
-        "ffts(start_freq end_freq=-1)",                                                                                 \
+        "ffts(start_freq end_freq=-1 bands=false)",                                                                     \
                                                                                                                         \
         "Creates 1024 buckets that map to a region of audible frequencies and applies smoothing to it.\n"               \
         "Each returns a value of roughly 0..1 based on the intensity of sound at that frequency at that time.\n"        \
         "If end_freq is not provided, a single value is returned for the start_freq.\n"                                 \
-        "If end_freq is provided, a sum of all values in the range is returned.",                                       \
-        2,                                                                                                              \
+        "If end_freq is provided, a sum of all values in the range is returned.\n"                                      \
+        "If bands is true, start_freq and end_freq index 32 log-frequency bands instead of the buckets.",               \
+        3,                                                                                                              \
         1,                                                                                                              \
         0,                                                                                                              \
         double,                                                                                                         \
-        tic_mem*, s32 startFreq, s32 endFreq)
+        tic_mem*, s32 startFreq, s32 endFreq, bool bands)                                                               \
+                                                                                                                        \
+                                                                                                                        \
+    macro(memput,                                                                                                       \
+        "memput(dest data)",                                                                                            \
+                                                                                                                        \
+        "This function copies a string or byte buffer owned by the script into TIC's RAM at the dest address.\n"        \
+        "It replaces a loop of poke() calls with a single call.\n"                                                      \
+        "Like memcpy, nothing is copied if the data doesn't fit in the 96K RAM.",                                       \
+        2,                                                                                                              \
+        2,                                                                                                              \
+        0,                                                                                                              \
+        void,                                                                                                           \
+        tic_mem*, s32 dst, const void* src, s32 size)                                                                   \
+                                                                                                                        \
+                                                                                                                        \
+    macro(blit,                                                                                                         \
+        "blit(x y w h data packed=false)",                                                                              \
+                                                                                                                        \
+        "This function draws a w*h block of pixels from a string or byte buffer owned by the script.\n"                 \
+        "By default each byte holds one pixel color, only its low 4 bits are used.\n"                                   \
+        "With packed=true each byte holds two pixels like the screen memory does, low nibble first, "                   \
+        "and every row starts on a new byte.\n"                                                                         \
+        "Colors go through the palette map and the clip rectangle like pix(), "                                         \
+        "rows missing at the end of data are left untouched.",                                                          \
+        6,                                                                                                              \
+        5,                                                                                                              \
+        0,                                                                                                              \
+        void,                                                                                                           \
+        tic_mem*, s32 x, s32 y, s32 width, s32 height, const void* data, s32 size, bool packed)
 
 #define TIC_API_DEF(name, _, __, ___, ____, _____, ret, ...) ret tic_api_##name(__VA_ARGS__);
 TIC_API_LIST(TIC_API_DEF)
@@ -870,6 +914,11 @@ void tic_core_synth_sound(tic_mem* tic);
 void tic_core_blit(tic_mem* tic);
 void tic_core_blit_ex(tic_mem* tic, tic_blit_callback clb);
 
+void tic_core_blit_threads(tic_mem* tic, s32 threads);
+
+struct tic_capture;
+void tic_core_capture(tic_mem* tic, struct tic_capture* capture);
+
 #define VBANK(tic, bank)                                \
     bool MACROVAR(_bank_) = tic_api_vbank(tic, bank);   \
     SCOPE(tic_api_vbank(tic, MACROVAR(_bank_)))
@@ -54,8 +54,8 @@ static bool initFennel(tic_mem* tic, const char* code)
 
         lua_settop(fennel, 0);
 
-        if (luaL_loadbuffer(fennel, (const char *)loadfennel_lua,
-                            loadfennel_lua_len, "fennel.lua") != LUA_OK)
+        if (luaapi_load(core, (const char *)loadfennel_lua,
+                        loadfennel_lua_len, "fennel.lua", "fennel.lua") != LUA_OK)
         {
             core->data->error(core->data->data, "failed to load fennel compiler");
             return false;
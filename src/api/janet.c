@@ -81,13 +81,15 @@ static Janet janet_fget(int32_t argc, Janet* argv);
 static Janet janet_fset(int32_t argc, Janet* argv);
 static Janet janet_fft(int32_t argc, Janet* argv);
 static Janet janet_ffts(int32_t argc, Janet* argv);
+static Janet janet_memput(int32_t argc, Janet* argv);
+static Janet janet_blit(int32_t argc, Janet* argv);
 
 static void closeJanet(tic_mem* tic);
 static bool initJanet(tic_mem* tic, const char* code);
 static void evalJanet(tic_mem* tic, const char* code);
 static void callJanetTick(tic_mem* tic);
 static void callJanetBoot(tic_mem* tic);
-static void callJanetIntCallback(tic_mem* tic, s32 value, void* data, const char* name);
+static void callJanetIntCallback(tic_mem* tic, s32 value, JanetFunction* fn);
 static void callJanetScanline(tic_mem* tic, s32 row, void* data);
 static void callJanetBorder(tic_mem* tic, s32 row, void* data);
 static void callJanetMenu(tic_mem* tic, s32 index, void* data);
@@ -146,6 +148,8 @@ static const JanetReg janet_c_functions[] =
     {"fset", janet_fset, NULL},
     {"fft", janet_fft, NULL},
     {"ffts", janet_ffts, NULL},
+    {"memput", janet_memput, NULL},
+    {"blit", janet_blit, NULL},
     {NULL, NULL, NULL}
 };
 
@@ -1058,7 +1062,7 @@ static Janet janet_fset(int32_t argc, Janet* argv)
 
 static Janet janet_fft(int32_t argc, Janet* argv)
 {
-    janet_arity(argc, 1, 2);
+    janet_arity(argc, 1, 3);
 
     s32 start_freq = -1;
     s32 end_freq = -1;
@@ -1066,13 +1070,15 @@ static Janet janet_fft(int32_t argc, Janet* argv)
     if (argc >= 1) start_freq = janet_getinteger(argv, 0);
     if (argc >= 2) end_freq = janet_getinteger(argv, 1);
 
+    bool bands = janet_optboolean(argv, argc, 2, false);
+
     tic_core* core = getJanetMachine(); tic_mem* tic = (tic_mem*)core;
-    return janet_wrap_number(core->api.fft(tic, start_freq, end_freq));
+    return janet_wrap_number(core->api.fft(tic, start_freq, end_freq, bands));
 }
 
 static Janet janet_ffts(int32_t argc, Janet* argv)
 {
-    janet_arity(argc, 1, 2);
+    janet_arity(argc, 1, 3);
 
     s32 start_freq = -1;
     s32 end_freq = -1;
@@ -1080,8 +1086,40 @@ static Janet janet_ffts(int32_t argc, Janet* argv)
     if (argc >= 1) start_freq = janet_getinteger(argv, 0);
     if (argc >= 2) end_freq = janet_getinteger(argv, 1);
 
+    bool bands = janet_optboolean(argv, argc, 2, false);
+
+    tic_core* core = getJanetMachine(); tic_mem* tic = (tic_mem*)core;
+    return janet_wrap_number(core->api.ffts(tic, start_freq, end_freq, bands));
+}
+
+static Janet janet_memput(int32_t argc, Janet* argv)
+{
+    janet_fixarity(argc, 2);
+
+    s32 dst = janet_getinteger(argv, 0);
+    JanetByteView data = janet_getbytes(argv, 1);
+
+    tic_core* core = getJanetMachine(); tic_mem* tic = (tic_mem*)core;
+
+    core->api.memput(tic, dst, data.bytes, data.len);
+    return janet_wrap_nil();
+}
+
+static Janet janet_blit(int32_t argc, Janet* argv)
+{
+    janet_arity(argc, 5, 6);
+
+    s32 x = janet_getinteger(argv, 0);
+    s32 y = janet_getinteger(argv, 1);
+    s32 w = janet_getinteger(argv, 2);
+    s32 h = janet_getinteger(argv, 3);
+    JanetByteView data = janet_getbytes(argv, 4);
+    bool packed = janet_optboolean(argv, argc, 5, false);
+
     tic_core* core = getJanetMachine(); tic_mem* tic = (tic_mem*)core;
-    return janet_wrap_number(core->api.fft(tic, start_freq, end_freq));
+
+    core->api.blit(tic, x, y, w, h, data.bytes, data.len, packed);
+    return janet_wrap_nil();
 }
 
 /* ***************** */
@@ -1093,11 +1131,92 @@ static void reportError(tic_core* core, Janet result)
 }
 
 
+/*
+ * Global callbacks, looked up once per frame instead of on every call,
+ * rooted so the GC keeps them alive until the next lookup.
+ */
+static struct
+{
+    JanetFunction* tic;
+    JanetFunction* scn;
+    JanetFunction* scanline;
+    JanetFunction* bdr;
+    JanetFunction* menu;
+    JanetFunction* ovr;
+} Callbacks;
+
+static void releaseCallbacks(void)
+{
+    JanetFunction** all[] = {&Callbacks.tic, &Callbacks.scn, &Callbacks.scanline, &Callbacks.bdr, &Callbacks.menu, &Callbacks.ovr};
+
+    for (s32 i = 0; i < COUNT_OF(all); i++) {
+        if (*all[i]) {
+            janet_gcunroot(janet_wrap_function(*all[i]));
+            *all[i] = NULL;
+        }
+    }
+}
+
+static JanetFunction* getCallback(JanetTable* env, const char* name)
+{
+    Janet pre_fn;
+    (void)janet_resolve(env, janet_csymbol(name), &pre_fn);
+
+    if (janet_type(pre_fn) != JANET_FUNCTION) {
+        return NULL;
+    }
+
+    janet_gcroot(pre_fn);
+    return janet_unwrap_function(pre_fn);
+}
+
+static void updateCallback(JanetTable* env, JanetFunction** func, const char* name)
+{
+    if (*func) {
+        janet_gcunroot(janet_wrap_function(*func));
+    }
+
+    *func = getCallback(env, name);
+}
+
+/*
+ * TIC is looked up right before it runs.
+ */
+static void resolveTickCallbacks(tic_core* core)
+{
+    JanetTable* env = core->currentVM;
+
+    updateCallback(env, &Callbacks.tic, TIC_FN);
+#if defined(BUILD_DEPRECATED)
+    updateCallback(env, &Callbacks.ovr, OVR_FN);
+#endif
+}
+
+/*
+ * The others after BOOT and after every TIC, which may (re)define them.
+ */
+static void resolveCallbacks(tic_core* core)
+{
+    JanetTable* env = core->currentVM;
+
+    updateCallback(env, &Callbacks.scn, SCN_FN);
+    // old scanline name
+    updateCallback(env, &Callbacks.scanline, "scanline");
+    updateCallback(env, &Callbacks.bdr, BDR_FN);
+    updateCallback(env, &Callbacks.menu, MENU_FN);
+
+    core->callbacks = tic_script_probed
+        | (Callbacks.scn || Callbacks.scanline ? tic_script_scn : 0)
+        | (Callbacks.bdr ? tic_script_bdr : 0)
+        | (Callbacks.menu ? tic_script_menu : 0);
+}
+
 static void closeJanet(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
 
     if (core->currentVM) {
+        releaseCallbacks();
         janet_deinit();
         core->currentVM = NULL;
         CurrentMachine = NULL;
@@ -1116,11 +1235,15 @@ static bool initJanet(tic_mem* tic, const char* code)
     JanetTable *sub_env = janet_table(0);
     janet_cfuns(sub_env, "tic80", janet_c_functions);
 
+    // RAM bytes as a buffer over tic_ram, it can't grow so out of range puts panic
+    tic_core* core = (tic_core*)tic;
+    JanetBuffer* ram = janet_pointer_buffer_unsafe(core->memory.ram, TIC_RAM_SIZE, TIC_RAM_SIZE);
+    janet_def(sub_env, "ram", janet_wrap_buffer(ram), "RAM bytes, read and written in place with get/put.");
+
     // Provide the tic80 api as a module
     Janet module_cache = janet_resolve_core("module/cache");
     janet_table_put(janet_unwrap_table(module_cache), janet_cstringv("tic80"), janet_wrap_table(sub_env));
 
-    tic_core* core = (tic_core*)tic;
     CurrentMachine = core;
     core->currentVM = (JanetTable*)janet_core_env(NULL);
 
@@ -1149,29 +1272,28 @@ static void evalJanet(tic_mem* tic, const char* code)
   if (janet_dostring(core->currentVM, code, "main", &result)) {
       reportError(core, result);
   }
+
+  // eval may (re)define callbacks
+  resolveCallbacks(core);
 }
 
 
 /*
- * Find a function called TIC_FN and execute it. If we can't find it, then
- * it is a problem.
+ * Run the current TIC_FN. If there is none, then it is a problem.
  */
 static void callJanetTick(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
 
-    // Load the TIC function
-    Janet pre_fn;
-    (void)janet_resolve(core->currentVM, janet_csymbol(TIC_FN), &pre_fn);
+    resolveTickCallbacks(core);
 
-    if (janet_type(pre_fn) != JANET_FUNCTION) {
+    if (!Callbacks.tic) {
         core->data->error(core->data->data, "(TIC) isn't found :(");
         return;
     }
 
-    JanetFunction *tic_fn = janet_unwrap_function(pre_fn);
     Janet result = janet_wrap_nil();
-    JanetSignal status = janet_pcall(tic_fn, 0, NULL, &result, &GameFiber);
+    JanetSignal status = janet_pcall(Callbacks.tic, 0, NULL, &result, &GameFiber);
 
     if (status != JANET_SIGNAL_OK) {
         reportError(core, result);
@@ -1179,21 +1301,21 @@ static void callJanetTick(tic_mem* tic)
 
 #if defined(BUILD_DEPRECATED)
     // call OVR() callback for backward compatibility
-    (void)janet_resolve(core->currentVM, janet_csymbol(OVR_FN), &pre_fn);
-    if (janet_type(pre_fn) == JANET_FUNCTION) {
-        JanetFunction *ovr_fn = janet_unwrap_function(pre_fn);
-        JanetSignal status = janet_pcall(ovr_fn, 0, NULL, &result, &GameFiber);
+    if (Callbacks.ovr) {
+        JanetSignal status = janet_pcall(Callbacks.ovr, 0, NULL, &result, &GameFiber);
 
         if (status != JANET_SIGNAL_OK) {
             reportError(core, result);
         }
     }
 #endif
+
+    resolveCallbacks(core);
 }
 
 /*
  * Find a function called BOOT_FN and execute it. If we can't find it, then
- * it's not a problem.
+ * it's not a problem. Either way the other callbacks are resolved here.
  */
 static void callJanetBoot(tic_mem* tic)
 {
@@ -1202,37 +1324,33 @@ static void callJanetBoot(tic_mem* tic)
     Janet pre_fn;
     (void)janet_resolve(core->currentVM, janet_csymbol(BOOT_FN), &pre_fn);
 
-    if (janet_type(pre_fn) != JANET_FUNCTION) {
-        return;
-    }
-
-    Janet result = janet_wrap_nil();
-    JanetFunction *boot_fn = janet_unwrap_function(pre_fn);
-    JanetSignal status = janet_pcall(boot_fn, 0, NULL, &result, &GameFiber);
+    if (janet_type(pre_fn) == JANET_FUNCTION) {
+        Janet result = janet_wrap_nil();
+        JanetFunction *boot_fn = janet_unwrap_function(pre_fn);
+        JanetSignal status = janet_pcall(boot_fn, 0, NULL, &result, &GameFiber);
 
-    if (status != JANET_SIGNAL_OK) {
-        reportError(core, result);
+        if (status != JANET_SIGNAL_OK) {
+            reportError(core, result);
+        }
     }
+
+    resolveCallbacks(core);
 }
 
 /*
- * Find a function with the given name and execute it with the given value.
- * If we can't find it, then it's not a problem.
+ * Execute a resolved callback with the given value. If the script doesn't
+ * define it, then it's not a problem.
  */
-static void callJanetIntCallback(tic_mem* tic, s32 value, void* data, const char* name)
+static void callJanetIntCallback(tic_mem* tic, s32 value, JanetFunction* fn)
 {
     tic_core* core = (tic_core*)tic;
 
-    Janet pre_fn;
-    (void)janet_resolve(core->currentVM, janet_csymbol(name), &pre_fn);
-
-    if (janet_type(pre_fn) != JANET_FUNCTION) {
+    if (!fn) {
         return;
     }
 
     Janet result = janet_wrap_nil();
     Janet argv[] = { janet_wrap_integer(value), };
-    JanetFunction *fn = janet_unwrap_function(pre_fn);
     JanetSignal status = janet_pcall(fn, 1, argv, &result, &GameFiber);
 
     if (status != JANET_SIGNAL_OK) {
@@ -1242,18 +1360,18 @@ static void callJanetIntCallback(tic_mem* tic, s32 value, void* data, const char
 
 static void callJanetScanline(tic_mem* tic, s32 row, void* data)
 {
-    callJanetIntCallback(tic, row, data, SCN_FN);
-    callJanetIntCallback(tic, row, data, "scanline");
+    callJanetIntCallback(tic, row, Callbacks.scn);
+    callJanetIntCallback(tic, row, Callbacks.scanline);
 }
 
 static void callJanetBorder(tic_mem* tic, s32 row, void* data)
 {
-    callJanetIntCallback(tic, row, data, BDR_FN);
+    callJanetIntCallback(tic, row, Callbacks.bdr);
 }
 
 static void callJanetMenu(tic_mem* tic, s32 index, void* data)
 {
-    callJanetIntCallback(tic, index, data, MENU_FN);
+    callJanetIntCallback(tic, index, Callbacks.menu);
 }
 
 static const tic_outline_item* getJanetOutline(const char* code, s32* size)
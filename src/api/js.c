@@ -110,6 +110,92 @@ static void js_std_dump_error(JSContext *ctx)
     JS_FreeValue(ctx, exception_val);
 }
 
+// global callbacks, looked up once per frame instead of on every call,
+// kept in the runtime opaque of the VM they belong to
+typedef struct
+{
+    JSValue tic;
+    JSValue scn;
+    JSValue scanline;
+    JSValue bdr;
+    JSValue menu;
+    JSValue ovr;
+} JsCallbacks;
+
+static inline JsCallbacks* getCallbacks(JSContext* ctx)
+{
+    return JS_GetRuntimeOpaque(JS_GetRuntime(ctx));
+}
+
+static void freeCallbacks(JSContext* ctx)
+{
+    JsCallbacks* callbacks = getCallbacks(ctx);
+
+    if(callbacks)
+    {
+        JS_FreeValue(ctx, callbacks->tic);
+        JS_FreeValue(ctx, callbacks->scn);
+        JS_FreeValue(ctx, callbacks->scanline);
+        JS_FreeValue(ctx, callbacks->bdr);
+        JS_FreeValue(ctx, callbacks->menu);
+        JS_FreeValue(ctx, callbacks->ovr);
+
+        free(callbacks);
+        JS_SetRuntimeOpaque(JS_GetRuntime(ctx), NULL);
+    }
+}
+
+static JSValue getCallback(JSContext* ctx, JSValue global, const char* name)
+{
+    JSValue func = JS_GetPropertyStr(ctx, global, name);
+
+    if(JS_IsFunction(ctx, func))
+        return func;
+
+    JS_FreeValue(ctx, func);
+    return JS_UNDEFINED;
+}
+
+static void updateCallback(JSContext* ctx, JSValue global, JSValue* func, const char* name)
+{
+    JS_FreeValue(ctx, *func);
+    *func = getCallback(ctx, global, name);
+}
+
+// TIC is looked up right before it runs
+static void resolveTickCallbacks(JSContext* ctx)
+{
+    JsCallbacks* callbacks = getCallbacks(ctx);
+    JSValue global = JS_GetGlobalObject(ctx);
+
+    updateCallback(ctx, global, &callbacks->tic, TIC_FN);
+#if defined(BUILD_DEPRECATED)
+    updateCallback(ctx, global, &callbacks->ovr, OVR_FN);
+#endif
+
+    JS_FreeValue(ctx, global);
+}
+
+// the others after BOOT and after every TIC, which may (re)assign them
+static void resolveCallbacks(tic_core* core, JSContext* ctx)
+{
+    JsCallbacks* callbacks = getCallbacks(ctx);
+    JSValue global = JS_GetGlobalObject(ctx);
+
+    updateCallback(ctx, global, &callbacks->scn, SCN_FN);
+    // old scanline() name
+    updateCallback(ctx, global, &callbacks->scanline, "scanline");
+    updateCallback(ctx, global, &callbacks->bdr, BDR_FN);
+    updateCallback(ctx, global, &callbacks->menu, MENU_FN);
+
+    JS_FreeValue(ctx, global);
+
+    core->callbacks = tic_script_probed
+        | (JS_IsUndefined(callbacks->scn) && JS_IsUndefined(callbacks->scanline) ? 0 : tic_script_scn)
+        | (JS_IsUndefined(callbacks->bdr) ? 0 : tic_script_bdr)
+        | (JS_IsUndefined(callbacks->menu) ? 0 : tic_script_menu);
+}
+
 static void closeJavascript(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
@@ -117,6 +203,8 @@ static void closeJavascript(tic_mem* tic)
 
     if(ctx)
     {
+        freeCallbacks(ctx);
+
         JSRuntime *rt = JS_GetRuntime(ctx);
         JS_FreeContext(ctx);
         JS_FreeRuntime(rt);
@@ -1019,8 +1107,9 @@ static JSValue js_fft(JSContext *ctx, JSValueConst this_val, s32 argc, JSValueCo
     tic_core* core = getCore(ctx); tic_mem* tic = (tic_mem*)core;
     s32 start_freq = getInteger(ctx, argv[0]);
     s32 end_freq = getInteger2(ctx, argv[1], -1);
+    bool bands = JS_ToBool(ctx, argv[2]);
 
-    return JS_NewFloat64(ctx, core->api.fft(tic, start_freq, end_freq));
+    return JS_NewFloat64(ctx, core->api.fft(tic, start_freq, end_freq, bands));
 }
 
 static JSValue js_ffts(JSContext *ctx, JSValueConst this_val, s32 argc, JSValueConst *argv)
@@ -1028,8 +1117,136 @@ static JSValue js_ffts(JSContext *ctx, JSValueConst this_val, s32 argc, JSValueC
     tic_core* core = getCore(ctx); tic_mem* tic = (tic_mem*)core;
     s32 start_freq = getInteger(ctx, argv[0]);
     s32 end_freq = getInteger2(ctx, argv[1], -1);
+    bool bands = JS_ToBool(ctx, argv[2]);
+
+    return JS_NewFloat64(ctx, core->api.ffts(tic, start_freq, end_freq, bands));
+}
+
+// bytes of an ArrayBuffer or a typed array view, without copying them
+static const u8* getBytes(JSContext *ctx, JSValueConst val, s32* size)
+{
+    size_t length = 0;
+    u8* data = JS_GetArrayBuffer(ctx, &length, val);
+
+    if(data)
+    {
+        *size = (s32)length;
+        return data;
+    }
+
+    // not an ArrayBuffer, that exception is replaced by the view lookup below
+    JS_FreeValue(ctx, JS_GetException(ctx));
+
+    size_t offset = 0, bytes = 0;
+    JSValue buffer = JS_GetTypedArrayBuffer(ctx, val, &offset, &bytes, NULL);
+
+    if(JS_IsException(buffer))
+        return NULL;
+
+    data = JS_GetArrayBuffer(ctx, &length, buffer);
+    JS_FreeValue(ctx, buffer);
+
+    if(!data || offset + bytes > length)
+        return NULL;
+
+    *size = (s32)bytes;
+    return data + offset;
+}
+
+static JSValue js_memput(JSContext *ctx, JSValueConst this_val, s32 argc, JSValueConst *argv)
+{
+    s32 dest = getInteger(ctx, argv[0]);
+
+    s32 size = 0;
+    const u8* data = getBytes(ctx, argv[1], &size);
+
+    if(!data)
+        return JS_ThrowTypeError(ctx, "invalid params, memput(dest, data) expects an ArrayBuffer or a typed array");
+
+    tic_core* core = getCore(ctx); tic_mem* tic = (tic_mem*)core;
+
+    core->api.memput(tic, dest, data, size);
+
+    return JS_UNDEFINED;
+}
+
+static JSValue js_blit(JSContext *ctx, JSValueConst this_val, s32 argc, JSValueConst *argv)
+{
+    s32 x = getInteger(ctx, argv[0]);
+    s32 y = getInteger(ctx, argv[1]);
+    s32 w = getInteger(ctx, argv[2]);
+    s32 h = getInteger(ctx, argv[3]);
+
+    s32 size = 0;
+    const u8* data = getBytes(ctx, argv[4], &size);
+
+    if(!data)
+        return JS_ThrowTypeError(ctx, "invalid params, blit(x, y, w, h, data, packed) expects an ArrayBuffer or a typed array");
 
-    return JS_NewFloat64(ctx, core->api.ffts(tic, start_freq, end_freq));
+    bool packed = JS_ToBool(ctx, argv[5]);
+
+    tic_core* core = getCore(ctx); tic_mem* tic = (tic_mem*)core;
+
+    core->api.blit(tic, x, y, w, h, data, size, packed);
+
+    return JS_UNDEFINED;
+}
+
+// ram is a Uint8Array over tic_ram, scripts index RAM bytes in place
+// instead of calling peek/poke for every access
+static void defineRamView(JSContext* ctx, JSValue global, tic_core* core)
+{
+    // no free callback, the buffer belongs to the core and outlives the context
+    JSValue buffer = JS_NewArrayBuffer(ctx, (u8*)core->memory.ram, TIC_RAM_SIZE, NULL, NULL, false);
+    JSValue ctor = JS_GetPropertyStr(ctx, global, "Uint8Array");
+    JSValue view = JS_CallConstructor(ctx, ctor, 1, &buffer);
+
+    JS_FreeValue(ctx, ctor);
+    JS_FreeValue(ctx, buffer);
+
+    if(JS_IsException(view))
+        js_std_dump_error(ctx);
+    else
+        JS_SetPropertyStr(ctx, global, "ram", view);
+}
+
+static JSValue compileJavascript(JSContext* ctx, const char* code, size_t size, const char* name)
+{
+    const tic_tick_data* data = getCore(ctx)->data;
+
+    if(data && data->cacheLoad)
+    {
+        s32 cachedSize = 0;
+        void* cached = data->cacheLoad(data->data, "quickjs", code, (s32)size, &cachedSize);
+
+        if(cached)
+        {
+            JSValue func = JS_ReadObject(ctx, cached, cachedSize, JS_READ_OBJ_BYTECODE);
+            free(cached);
+
+            if(!JS_IsException(func))
+                return func;
+
+            // bytecode of another engine version, compile the source again
+            JS_FreeValue(ctx, JS_GetException(ctx));
+        }
+    }
+
+    JSValue func = JS_Eval(ctx, code, size, name, JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+
+    if(!JS_IsException(func) && data && data->cacheStore)
+    {
+        size_t bytecodeSize = 0;
+        u8* bytecode = JS_WriteObject(ctx, &bytecodeSize, func, JS_WRITE_OBJ_BYTECODE);
+
+        if(bytecode)
+        {
+            data->cacheStore(data->data, "quickjs", code, (s32)size, bytecode, (s32)bytecodeSize);
+            js_free(ctx, bytecode);
+        }
+    }
+
+    return func;
 }
 
 static bool initJavascript(tic_mem* tic, const char* code)
@@ -1043,6 +1260,19 @@ static bool initJavascript(tic_mem* tic, const char* code)
     core->currentVM = ctx;
     JS_SetContextOpaque(ctx, core);
 
+    {
+        JsCallbacks* callbacks = malloc(sizeof(JsCallbacks));
+
+        if(!callbacks)
+        {
+            closeJavascript(tic);
+            return false;
+        }
+
+        *callbacks = (JsCallbacks){JS_UNDEFINED, JS_UNDEFINED, JS_UNDEFINED, JS_UNDEFINED, JS_UNDEFINED, JS_UNDEFINED};
+        JS_SetRuntimeOpaque(rt, callbacks);
+    }
+
     {
         JSValue global = JS_GetGlobalObject(ctx);
 
@@ -1057,10 +1287,16 @@ static bool initJavascript(tic_mem* tic, const char* code)
 
 #undef  API_FUNC_DEF
 
+        defineRamView(ctx, global, core);
+
         JS_FreeValue(ctx, global);
     }
 
-    JSValue ret = JS_Eval(ctx, code, strlen(code), "index.js", JS_EVAL_TYPE_GLOBAL);
+    JSValue ret = compileJavascript(ctx, code, strlen(code), "index.js");
+
+    if (!JS_IsException(ret))
+        ret = JS_EvalFunction(ctx, ret);
+
     if (JS_IsException(ret))
     {
         js_std_dump_error(ctx);
@@ -1107,10 +1343,11 @@ static void callJavascriptTick(tic_mem* tic)
 
     if(ctx)
     {
-        JSValue global = JS_GetGlobalObject(ctx);
-        JSValue func = JS_GetPropertyStr(ctx, global, TIC_FN);
+        JsCallbacks* callbacks = getCallbacks(ctx);
 
-        if(JS_IsFunction(ctx, func))
+        resolveTickCallbacks(ctx);
+
+        if(!JS_IsUndefined(callbacks->tic))
         {
             {
                 JSContext *ctx1;
@@ -1129,66 +1366,67 @@ static void callJavascriptTick(tic_mem* tic)
                 }
             }
 
-            if(callFunc(ctx, func, global))
+            JSValue global = JS_GetGlobalObject(ctx);
+
+            if(callFunc(ctx, callbacks->tic, global))
             {
 #if defined(BUILD_DEPRECATED)
                 // call OVR() callback for backward compatibility
+                if(!JS_IsUndefined(callbacks->ovr))
                 {
-                    JSValue ovrfunc = JS_GetPropertyStr(ctx, global, OVR_FN);
-
-                    if(JS_IsFunction(ctx, ovrfunc))
+                    OVR(core)
                     {
-                        OVR(core)
-                        {
-                            callFunc(ctx, ovrfunc, global);
-                        }
+                        callFunc(ctx, callbacks->ovr, global);
                     }
-
-                    JS_FreeValue(ctx, ovrfunc);
                 }
 #endif
             }
+
+            JS_FreeValue(ctx, global);
+
+            resolveCallbacks(core, ctx);
         }
         else core->data->error(core->data->data, "'function TIC()...' isn't found :(");
-
-        JS_FreeValue(ctx, func);
-        JS_FreeValue(ctx, global);
     }
 }
 
-static void callJavascriptIntCallback(tic_mem* tic, s32 value, void* data, const char* name)
+static void callJavascriptIntCallback(JSContext* ctx, s32 value, JSValue func)
 {
-    tic_core* core = (tic_core*)tic;
-    JSContext* ctx = core->currentVM;
-
-    JSValue global = JS_GetGlobalObject(ctx);
-    JSValue func = JS_GetPropertyStr(ctx, global, name);
-
-    if(JS_IsFunction(ctx, func))
+    if(!JS_IsUndefined(func))
     {
+        JSValue global = JS_GetGlobalObject(ctx);
         callFunc1(ctx, func, global, JS_NewInt32(ctx, value));
+        JS_FreeValue(ctx, global);
     }
-
-    JS_FreeValue(ctx, func);
-    JS_FreeValue(ctx, global);
 }
 
 static void callJavascriptScanline(tic_mem* tic, s32 row, void* data)
 {
-    callJavascriptIntCallback(tic, row, data, SCN_FN);
+    JSContext* ctx = ((tic_core*)tic)->currentVM;
 
-    // try to call old scanline
-    callJavascriptIntCallback(tic, row, data, "scanline");
+    if(ctx)
+    {
+        callJavascriptIntCallback(ctx, row, getCallbacks(ctx)->scn);
+
+        // try to call old scanline
+        callJavascriptIntCallback(ctx, row, getCallbacks(ctx)->scanline);
+    }
 }
 
 static void callJavascriptBorder(tic_mem* tic, s32 row, void* data)
 {
-    callJavascriptIntCallback(tic, row, data, BDR_FN);
+    JSContext* ctx = ((tic_core*)tic)->currentVM;
+
+    if(ctx)
+        callJavascriptIntCallback(ctx, row, getCallbacks(ctx)->bdr);
 }
 
 static void callJavascriptMenu(tic_mem* tic, s32 index, void* data)
 {
-    callJavascriptIntCallback(tic, index, data, MENU_FN);
+    JSContext* ctx = ((tic_core*)tic)->currentVM;
+
+    if(ctx)
+        callJavascriptIntCallback(ctx, index, getCallbacks(ctx)->menu);
 }
 
 static void callJavascriptBoot(tic_mem* tic)
@@ -1206,6 +1444,8 @@ static void callJavascriptBoot(tic_mem* tic)
 
     JS_FreeValue(ctx, func);
     JS_FreeValue(ctx, global);
+
+    resolveCallbacks(core, ctx);
 }
 
 static const char* const JsKeywords [] =
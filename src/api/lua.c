@@ -45,7 +45,7 @@ static bool initLua(tic_mem* tic, const char* code)
 
         lua_settop(lua, 0);
 
-        if(luaL_loadstring(lua, code) != LUA_OK || lua_pcall(lua, 0, LUA_MULTRET, 0) != LUA_OK)
+        if(luaapi_load(core, code, strlen(code), code, "lua") != LUA_OK || lua_pcall(lua, 0, LUA_MULTRET, 0) != LUA_OK)
         {
             core->data->error(core->data->data, lua_tostring(lua, -1));
             return false;
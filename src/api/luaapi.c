@@ -1556,17 +1556,23 @@ static s32 lua_fft(lua_State* lua)
     {
         s32 start_freq = getLuaNumber(lua, 1);
         s32 end_freq = -1;
+        bool bands = false;
 
         if (top >= 2)
         {
             end_freq = getLuaNumber(lua, 2);
         }
 
-        lua_pushnumber(lua, core->api.fft(tic, start_freq, end_freq));
+        if (top >= 3)
+        {
+            bands = lua_toboolean(lua, 3);
+        }
+
+        lua_pushnumber(lua, core->api.fft(tic, start_freq, end_freq, bands));
         return 1;
     }
 
-    luaL_error(lua, "invalid params, fft(start_freq, end_freq=-1)\n");
+    luaL_error(lua, "invalid params, fft(start_freq, end_freq=-1, bands=false)\n");
     return 0;
 }
 
@@ -1581,20 +1587,131 @@ static s32 lua_ffts(lua_State* lua)
     {
         s32 start_freq = getLuaNumber(lua, 1);
         s32 end_freq = -1;
+        bool bands = false;
 
         if (top >= 2)
         {
             end_freq = getLuaNumber(lua, 2);
         }
 
-        lua_pushnumber(lua, core->api.ffts(tic, start_freq, end_freq));
+        if (top >= 3)
+        {
+            bands = lua_toboolean(lua, 3);
+        }
+
+        lua_pushnumber(lua, core->api.ffts(tic, start_freq, end_freq, bands));
         return 1;
     }
 
-    luaL_error(lua, "invalid params, ffts(start_freq, end_freq=-1)\n");
+    luaL_error(lua, "invalid params, ffts(start_freq, end_freq=-1, bands=false)\n");
     return 0;
 }
 
+static s32 lua_memput(lua_State* lua)
+{
+    s32 top = lua_gettop(lua);
+
+    if(top == 2 && lua_type(lua, 2) == LUA_TSTRING)
+    {
+        s32 dest = getLuaNumber(lua, 1);
+
+        size_t size;
+        const char* data = lua_tolstring(lua, 2, &size);
+
+        tic_core* core = getLuaCore(lua);
+        tic_mem* tic = (tic_mem*)core;
+
+        core->api.memput(tic, dest, data, (s32)size);
+    }
+    else luaL_error(lua, "invalid params, memput(dest,data)\n");
+
+    return 0;
+}
+
+static s32 lua_blit(lua_State* lua)
+{
+    s32 top = lua_gettop(lua);
+
+    if(top >= 5 && lua_type(lua, 5) == LUA_TSTRING)
+    {
+        s32 x = getLuaNumber(lua, 1);
+        s32 y = getLuaNumber(lua, 2);
+        s32 w = getLuaNumber(lua, 3);
+        s32 h = getLuaNumber(lua, 4);
+
+        size_t size;
+        const char* data = lua_tolstring(lua, 5, &size);
+        bool packed = top >= 6 && lua_toboolean(lua, 6);
+
+        tic_core* core = getLuaCore(lua);
+        tic_mem* tic = (tic_mem*)core;
+
+        core->api.blit(tic, x, y, w, h, data, (s32)size, packed);
+    }
+    else luaL_error(lua, "invalid params, blit(x,y,w,h,data,packed=false)\n");
+
+    return 0;
+}
+
+static s32 lua_ram_index(lua_State* lua)
+{
+    tic_core* core = lua_touserdata(lua, lua_upvalueindex(1));
+    lua_Integer address = luaL_checkinteger(lua, 2);
+
+    if(address >= 0 && address < TIC_RAM_SIZE)
+        lua_pushinteger(lua, ((u8*)core->memory.ram)[address]);
+    else
+        lua_pushnil(lua);
+
+    return 1;
+}
+
+static s32 lua_ram_newindex(lua_State* lua)
+{
+    tic_core* core = lua_touserdata(lua, lua_upvalueindex(1));
+    lua_Integer address = luaL_checkinteger(lua, 2);
+    lua_Integer value = luaL_checkinteger(lua, 3);
+
+    luaL_argcheck(lua, address >= 0 && address < TIC_RAM_SIZE, 2, "ram address out of range");
+
+    ((u8*)core->memory.ram)[address] = (u8)value;
+
+    return 0;
+}
+
+static s32 lua_ram_len(lua_State* lua)
+{
+    lua_pushinteger(lua, TIC_RAM_SIZE);
+    return 1;
+}
+
+// ram[address] reads and writes RAM bytes in place, it skips the peek/poke dispatch
+// and the global lookup of the API function on every access
+static void registerLuaRamView(tic_core* core)
+{
+    lua_State* lua = core->currentVM;
+
+    static const luaL_Reg Meta[] =
+    {
+        {"__index", lua_ram_index},
+        {"__newindex", lua_ram_newindex},
+        {"__len", lua_ram_len},
+    };
+
+    lua_newuserdata(lua, 0);
+    lua_createtable(lua, 0, COUNT_OF(Meta));
+
+    for (s32 i = 0; i < COUNT_OF(Meta); i++)
+    {
+        lua_pushlightuserdata(lua, core);
+        lua_pushcclosure(lua, Meta[i].func, 1);
+        lua_setfield(lua, -2, Meta[i].name);
+    }
+
+    lua_setmetatable(lua, -2);
+    lua_setglobal(lua, "ram");
+}
+
 static int lua_dofile(lua_State *lua)
 {
     luaL_error(lua, "unknown method: \"dofile\"\n");
@@ -1630,6 +1747,68 @@ void luaapi_open(lua_State *lua)
     }
 }
 
+typedef struct
+{
+    u8* data;
+    size_t size;
+} LuaChunk;
+
+static int writeLuaChunk(lua_State* lua, const void* ptr, size_t size, void* ud)
+{
+    LuaChunk* chunk = ud;
+    u8* data = realloc(chunk->data, chunk->size + size);
+
+    if(!data)
+        return 1;
+
+    memcpy(data + chunk->size, ptr, size);
+    chunk->data = data;
+    chunk->size += size;
+
+    return 0;
+}
+
+s32 luaapi_load(tic_core* core, const char* code, size_t size, const char* name, const char* tag)
+{
+    lua_State* lua = core->currentVM;
+    const tic_tick_data* data = core->data;
+
+    char fulltag[64];
+    snprintf(fulltag, sizeof fulltag, "%s %s", LUA_RELEASE, tag);
+
+    if(data && data->cacheLoad)
+    {
+        s32 cachedSize = 0;
+        void* cached = data->cacheLoad(data->data, fulltag, code, (s32)size, &cachedSize);
+
+        if(cached)
+        {
+            s32 status = luaL_loadbufferx(lua, cached, cachedSize, name, "b");
+            free(cached);
+
+            if(status == LUA_OK)
+                return status;
+
+            // stale or foreign bytecode, compile the source and replace it
+            lua_pop(lua, 1);
+        }
+    }
+
+    s32 status = luaL_loadbuffer(lua, code, size, name);
+
+    if(status == LUA_OK && data && data->cacheStore)
+    {
+        LuaChunk chunk = {0};
+
+        if(lua_dump(lua, writeLuaChunk, &chunk, 0) == 0 && chunk.size)
+            data->cacheStore(data->data, fulltag, code, (s32)size, chunk.data, (s32)chunk.size);
+
+        free(chunk.data);
+    }
+
+    return status;
+}
+
 void luaapi_init(tic_core* core)
 {
     static const struct{lua_CFunction func; const char* name;} ApiItems[] =
@@ -1648,6 +1827,8 @@ void luaapi_init(tic_core* core)
 
     registerLuaFunction(core, lua_dofile, "dofile");
     registerLuaFunction(core, lua_loadfile, "loadfile");
+
+    registerLuaRamView(core);
 }
 
 void luaapi_close(tic_mem* tic)
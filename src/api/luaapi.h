@@ -37,3 +37,6 @@ void luaapi_bdr(tic_mem* tic, s32 row, void* data);
 void luaapi_menu(tic_mem* tic, s32 index, void* data);
 void luaapi_close(tic_mem* tic);
 void luaapi_open(lua_State *lua);
+// loads the chunk like luaL_loadbuffer, reusing the bytecode from the host cache if there is one,
+// `tag` names the cache entry and must not change with the code (the chunk name may)
+s32 luaapi_load(tic_core* core, const char* code, size_t size, const char* name, const char* tag);
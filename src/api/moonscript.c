@@ -92,7 +92,7 @@ static bool initMoonscript(tic_mem* tic, const char* code)
 
         lua_settop(moon, 0);
 
-        if (luaL_loadbuffer(moon, (const char *)moonscript_lua, moonscript_lua_len, "moonscript.lua") != LUA_OK)
+        if (luaapi_load(core, (const char *)moonscript_lua, moonscript_lua_len, "moonscript.lua", "moonscript.lua") != LUA_OK)
         {
             core->data->error(core->data->data, "failed to load moonscript.lua");
             return false;
@@ -42,6 +42,16 @@ extern bool parse_note(const char* noteStr, s32* note, s32* octave);
 typedef struct {
     struct mrb_state* mrb;
     struct mrbc_context* mrb_cxt;
+
+    // global callbacks, checked again after every TIC, 0 if not defined
+    struct
+    {
+        mrb_sym tic;
+        mrb_sym scn;
+        mrb_sym scanline;
+        mrb_sym bdr;
+        mrb_sym menu;
+    } callbacks;
 } mrbVm;
 
 static tic_core* CurrentMachine = NULL;
@@ -533,38 +543,79 @@ static mrb_value mrb_fset(mrb_state* mrb, mrb_value self)
 static mrb_value mrb_fft(mrb_state* mrb, mrb_value self)
 {
     mrb_int start_freq, end_freq = -1;
-    mrb_int argc = mrb_get_args(mrb, "i|i", &start_freq, &end_freq);
+    mrb_bool bands = false;
+    mrb_int argc = mrb_get_args(mrb, "i|ib", &start_freq, &end_freq, &bands);
 
     tic_core* core = getMRubyMachine(mrb);
     tic_mem* tic = (tic_mem*)core;
 
     if (argc == 0)
     {
-        mrb_raise(mrb, E_ARGUMENT_ERROR, "invalid params, fft [ start_freq end_freq ]\n");
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "invalid params, fft [ start_freq end_freq bands ]\n");
         return mrb_nil_value();
     }
     else
     {
-        return mrb_float_value(mrb, core->api.fft(tic, start_freq, end_freq));
+        return mrb_float_value(mrb, core->api.fft(tic, start_freq, end_freq, bands));
+    }
+}
+
+static mrb_value mrb_memput(mrb_state* mrb, mrb_value self)
+{
+    mrb_int dest;
+    char* data;
+    mrb_int size;
+    mrb_get_args(mrb, "is", &dest, &data, &size);
+
+    s32 bound = sizeof(tic_ram) - size;
+
+    if(size <= sizeof(tic_ram) && dest >= 0 && dest <= bound)
+    {
+        tic_core* core = getMRubyMachine(mrb); tic_mem* tic = (tic_mem*)core;
+
+        core->api.memput(tic, dest, data, size);
+    }
+    else
+    {
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "tic address not in range!");
     }
+
+    return mrb_nil_value();
+}
+
+static mrb_value mrb_blit(mrb_state* mrb, mrb_value self)
+{
+    mrb_int x, y, w, h;
+    char* data;
+    mrb_int size;
+    mrb_bool packed = false;
+    mrb_get_args(mrb, "iiiis|b", &x, &y, &w, &h, &data, &size, &packed);
+
+    tic_core* core = getMRubyMachine(mrb);
+    tic_mem* tic = (tic_mem*)core;
+
+    core->api.blit(tic, x, y, w, h, data, size, packed);
+
+    return mrb_nil_value();
 }
 
 static mrb_value mrb_ffts(mrb_state* mrb, mrb_value self)
 {
     mrb_int start_freq, end_freq = -1;
-    mrb_int argc = mrb_get_args(mrb, "i|i", &start_freq, &end_freq);
+    mrb_bool bands = false;
+    mrb_int argc = mrb_get_args(mrb, "i|ib", &start_freq, &end_freq, &bands);
 
     tic_core* core = getMRubyMachine(mrb);
     tic_mem* tic = (tic_mem*)core;
 
     if (argc == 0)
     {
-        mrb_raise(mrb, E_ARGUMENT_ERROR, "invalid params, ffts [ start_freq end_freq ]\n");
+        mrb_raise(mrb, E_ARGUMENT_ERROR, "invalid params, ffts [ start_freq end_freq bands ]\n");
         return mrb_nil_value();
     }
     else
     {
-        return mrb_float_value(mrb, core->api.ffts(tic, start_freq, end_freq));
+        return mrb_float_value(mrb, core->api.ffts(tic, start_freq, end_freq, bands));
     }
 }
 
@@ -1075,7 +1126,7 @@ static bool initMRuby(tic_mem* tic, const char* code)
 
     CurrentMachine = core;
 
-    core->currentVM = malloc(sizeof(mrbVm));
+    core->currentVM = calloc(1, sizeof(mrbVm));
     mrbVm *currentVM = (mrbVm*)core->currentVM;
 
     mrb_state* mrb = currentVM->mrb = mrb_open();
@@ -1104,6 +1155,29 @@ static bool initMRuby(tic_mem* tic, const char* code)
     return catcherr(core);
 }
 
+static mrb_sym getCallback(mrb_state* mrb, const char* name)
+{
+    mrb_sym sym = mrb_intern_cstr(mrb, name);
+    return mrb_respond_to(mrb, mrb_top_self(mrb), sym) ? sym : 0;
+}
+
+static void resolveCallbacks(tic_core* core)
+{
+    mrbVm* vm = (mrbVm*)core->currentVM;
+    mrb_state* mrb = vm->mrb;
+
+    vm->callbacks.scn = getCallback(mrb, SCN_FN);
+    // old scanline name
+    vm->callbacks.scanline = getCallback(mrb, "scanline");
+    vm->callbacks.bdr = getCallback(mrb, BDR_FN);
+    vm->callbacks.menu = getCallback(mrb, MENU_FN);
+
+    core->callbacks = tic_script_probed
+        | (vm->callbacks.scn || vm->callbacks.scanline ? tic_script_scn : 0)
+        | (vm->callbacks.bdr ? tic_script_bdr : 0)
+        | (vm->callbacks.menu ? tic_script_menu : 0);
+}
+
 static void evalMRuby(tic_mem* tic, const char* code) {
     tic_core* core = (tic_core*)tic;
 
@@ -1122,21 +1196,27 @@ static void evalMRuby(tic_mem* tic, const char* code) {
     mrbc_filename(mrb, mrb_cxt, "eval");
     mrb_load_string_cxt(mrb, code, mrb_cxt);
     catcherr(core);
+
+    // eval may (re)define callbacks
+    resolveCallbacks(core);
 }
 
 static void callMRubyTick(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
-    const char* TicFunc = TIC_FN;
-
-    mrb_state* mrb = ((mrbVm*)core->currentVM)->mrb;
+    mrbVm* vm = (mrbVm*)core->currentVM;
 
-    if(mrb)
+    if(vm && vm->mrb)
     {
-        if (mrb_respond_to(mrb, mrb_top_self(mrb), mrb_intern_cstr(mrb, TicFunc)))
+        // methods are called by name, only their presence can change
+        vm->callbacks.tic = getCallback(vm->mrb, TIC_FN);
+
+        if (vm->callbacks.tic)
         {
-            mrb_funcall(mrb, mrb_top_self(mrb), TicFunc, 0);
+            mrb_funcall_argv(vm->mrb, mrb_top_self(vm->mrb), vm->callbacks.tic, 0, NULL);
             catcherr(core);
+
+            resolveCallbacks(core);
         }
         else
         {
@@ -1159,36 +1239,45 @@ static void callMRubyBoot(tic_mem* tic)
             mrb_funcall(mrb, mrb_top_self(mrb), BootFunc, 0);
             catcherr(core);
         }
+
+        resolveCallbacks(core);
     }
 }
 
-static void callMRubyIntCallback(tic_mem* tic, s32 value, void* data, const char* name)
+static void callMRubyIntCallback(tic_mem* tic, s32 value, mrb_sym name)
 {
     tic_core* core = (tic_core*)tic;
     mrb_state* mrb = ((mrbVm*)core->currentVM)->mrb;
 
-    if (mrb && mrb_respond_to(mrb, mrb_top_self(mrb), mrb_intern_cstr(mrb, name)))
+    if (mrb && name)
     {
-        mrb_funcall(mrb, mrb_top_self(mrb), name, 1, mrb_fixnum_value(value));
+        mrb_value arg = mrb_fixnum_value(value);
+        mrb_funcall_argv(mrb, mrb_top_self(mrb), name, 1, &arg);
         catcherr(core);
     }
 }
 
 static void callMRubyScanline(tic_mem* tic, s32 row, void* data)
 {
-    callMRubyIntCallback(tic, row, data, SCN_FN);
+    mrbVm* vm = (mrbVm*)((tic_core*)tic)->currentVM;
+
+    callMRubyIntCallback(tic, row, vm->callbacks.scn);
 
-    callMRubyIntCallback(tic, row, data, "scanline");
+    callMRubyIntCallback(tic, row, vm->callbacks.scanline);
 }
 
 static void callMRubyBorder(tic_mem* tic, s32 row, void* data)
 {
-    callMRubyIntCallback(tic, row, data, BDR_FN);
+    mrbVm* vm = (mrbVm*)((tic_core*)tic)->currentVM;
+
+    callMRubyIntCallback(tic, row, vm->callbacks.bdr);
 }
 
 static void callMRubyMenu(tic_mem* tic, s32 index, void* data)
 {
-    callMRubyIntCallback(tic, index, data, MENU_FN);
+    mrbVm* vm = (mrbVm*)((tic_core*)tic)->currentVM;
+
+    callMRubyIntCallback(tic, index, vm->callbacks.menu);
 }
 
 /**
@@ -1112,6 +1112,97 @@ static bool py_vbank(int argc, py_Ref argv)
     return true;
 }
 
+static bool py_memput(int argc, py_Ref argv)
+{
+    int dest, size;
+    PY_CHECK_ARG_TYPE(0, tp_int);
+    PY_CHECK_ARG_TYPE(1, tp_bytes);
+    dest = py_toint(py_arg(0));
+    const unsigned char* data = py_tobytes(py_arg(1), &size);
+    tic_core* core = get_core();
+
+    tic_mem* tic = (tic_mem*)core;
+
+    core->api.memput(tic, dest, data, size);
+    py_assign(py_retval(), py_None());
+    return true;
+}
+static bool py_blit(int argc, py_Ref argv)
+{
+    int x, y, w, h, size;
+    bool packed;
+    PY_CHECK_ARG_TYPE(0, tp_int);
+    PY_CHECK_ARG_TYPE(1, tp_int);
+    PY_CHECK_ARG_TYPE(2, tp_int);
+    PY_CHECK_ARG_TYPE(3, tp_int);
+    PY_CHECK_ARG_TYPE(4, tp_bytes);
+    PY_CHECK_ARG_TYPE(5, tp_bool);
+    x = py_toint(py_arg(0));
+    y = py_toint(py_arg(1));
+    w = py_toint(py_arg(2));
+    h = py_toint(py_arg(3));
+    const unsigned char* data = py_tobytes(py_arg(4), &size);
+    packed = py_tobool(py_arg(5));
+    tic_core* core = get_core();
+
+    tic_mem* tic = (tic_mem*)core;
+
+    core->api.blit(tic, x, y, w, h, data, size, packed);
+    py_assign(py_retval(), py_None());
+    return true;
+}
+
+/*************TIC-80 RAM VIEW BEGIN****************/
+
+// ram[addr] reads and writes RAM bytes in place, without the peek/poke dispatch
+static bool py_ram_getitem(int argc, py_Ref argv)
+{
+    PY_CHECK_ARGC(2);
+    PY_CHECK_ARG_TYPE(1, tp_int);
+    py_i64 addr = py_toint(py_arg(1));
+    if (addr < 0 || addr >= TIC_RAM_SIZE)
+    {
+        return IndexError("ram address out of range");
+    }
+    tic_core* core = get_core();
+
+    py_newint(py_retval(), ((u8*)core->memory.ram)[addr]);
+    return true;
+}
+static bool py_ram_setitem(int argc, py_Ref argv)
+{
+    PY_CHECK_ARGC(3);
+    PY_CHECK_ARG_TYPE(1, tp_int);
+    PY_CHECK_ARG_TYPE(2, tp_int);
+    py_i64 addr = py_toint(py_arg(1));
+    if (addr < 0 || addr >= TIC_RAM_SIZE)
+    {
+        return IndexError("ram address out of range");
+    }
+    tic_core* core = get_core();
+
+    ((u8*)core->memory.ram)[addr] = (u8)py_toint(py_arg(2));
+    py_assign(py_retval(), py_None());
+    return true;
+}
+static bool py_ram_len(int argc, py_Ref argv)
+{
+    PY_CHECK_ARGC(1);
+    py_newint(py_retval(), TIC_RAM_SIZE);
+    return true;
+}
+
+static void bind_ram_view(py_GlobalRef mod)
+{
+    py_Type type = py_newtype("RAM", tp_object, mod, NULL);
+    py_bindmethod(type, "__getitem__", py_ram_getitem);
+    py_bindmethod(type, "__setitem__", py_ram_setitem);
+    py_bindmethod(type, "__len__", py_ram_len);
+
+    py_newobject(py_retval(), type, 0, 0);
+    py_setglobal(py_name("ram"), py_retval());
+}
+
 /*************TIC-80 MISC BEGIN****************/
 
 static bool py_throw_error(tic_core* core, const char* msg)
@@ -1130,6 +1221,7 @@ static bool py_throw_error(tic_core* core, const char* msg)
 static bool bind_pkpy_v2()
 {
     py_GlobalRef mod = py_getmodule("__main__");
+    py_bind(mod, "blit(x: int, y: int, w: int, h: int, data: bytes, packed=False)", py_blit);
     py_bind(mod, "btn(id: int) -> bool", py_btn);
     py_bind(mod, "btnp(id: int, hold=-1, period=-1) -> bool", py_btnp);
     py_bind(mod, "cls(color=0)", py_cls);
@@ -1151,6 +1243,7 @@ static bool bind_pkpy_v2()
     py_bind(mod, "map(x=0, y=0, w=30, h=17, sx=0, sy=0, colorkey=-1, scale=1, remap=None)", py_map);
     py_bind(mod, "memcpy(dest: int, source: int, size: int)", py_memcpy);
     py_bind(mod, "memset(dest: int, value: int, size: int)", py_memset);
+    py_bind(mod, "memput(dest: int, data: bytes)", py_memput);
     py_bind(mod, "mget(x: int, y: int) -> int", py_mget);
     py_bind(mod, "mset(x: int, y: int, tile_id: int)", py_mset);
     py_bind(mod, "mouse() -> tuple[int, int, bool, bool, bool, int, int]", py_mouse);
@@ -1177,6 +1270,8 @@ static bool bind_pkpy_v2()
     py_bind(mod, "trib(x1: float, y1: float, x2: float, y2: float, x3: float, y3: float, color: int)", py_trib);
     py_bind(mod, "tstamp() -> int", py_tstamp);
     py_bind(mod, "vbank(bank: int=None) -> int", py_vbank);
+
+    bind_ram_view(mod);
     return true;
 }
 
@@ -1217,6 +1312,31 @@ static bool init_pkpy_v2(tic_mem* tic, const char* code)
     return true;
 }
 
+// noted after BOOT and after every TIC, so the core skips the rows of the
+// missing ones; the present ones are looked up by the interned name per call
+static void resolve_callbacks(tic_core* core)
+{
+    core->callbacks = tic_script_probed
+        | (py_getglobal(N.SCN) ? tic_script_scn : 0)
+        | (py_getglobal(N.BDR) ? tic_script_bdr : 0)
+        | (py_getglobal(N.MENU) ? tic_script_menu : 0);
+}
+
+static void call_callback(tic_core* core, py_Name name, s32 value, const char* error)
+{
+    py_GlobalRef func = py_getglobal(name);
+    if (!func) return;
+    py_push(func);
+    py_pushnil();
+    py_Ref py_value = py_retval();
+    py_newint(py_value, value);
+    py_push(py_value);
+    if (!py_vectorcall(1, 0))
+    {
+        py_throw_error(core, error);
+    }
+}
+
 void tick_pkpy_v2(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
@@ -1230,6 +1350,8 @@ void tick_pkpy_v2(tic_mem* tic)
     {
         py_throw_error(core, "TIC running error!");
     }
+
+    resolve_callbacks(core);
 }
 
 void boot_pkpy_v2(tic_mem* tic)
@@ -1238,13 +1360,17 @@ void boot_pkpy_v2(tic_mem* tic)
     if (!core->currentVM) return; //no vm
 
     py_GlobalRef py_boot = py_getglobal(N.BOOT);
-    if (!py_boot) return;
-    py_push(py_boot);
-    py_pushnil();
-    if (!py_vectorcall(0, 0))
+    if (py_boot)
     {
-        py_throw_error(core, "BOOT running error!");
+        py_push(py_boot);
+        py_pushnil();
+        if (!py_vectorcall(0, 0))
+        {
+            py_throw_error(core, "BOOT running error!");
+        }
     }
+
+    resolve_callbacks(core);
 }
 
 void callback_scanline(tic_mem* tic, s32 row, void* data)
@@ -1252,17 +1378,7 @@ void callback_scanline(tic_mem* tic, s32 row, void* data)
     tic_core* core = (tic_core*)tic;
     if (!core->currentVM) return; //no vm
 
-    py_GlobalRef py_scn = py_getglobal(N.SCN);
-    if (!py_scn) return;
-    py_push(py_scn);
-    py_pushnil();
-    py_Ref py_row = py_retval();
-    py_newint(py_row, row);
-    py_push(py_row);
-    if (!py_vectorcall(1, 0))
-    {
-        py_throw_error(core, "SCANLINE running error!");
-    }
+    call_callback(core, N.SCN, row, "SCANLINE running error!");
 }
 
 void callback_border(tic_mem* tic, s32 row, void* data)
@@ -1270,34 +1386,14 @@ void callback_border(tic_mem* tic, s32 row, void* data)
     tic_core* core = (tic_core*)tic;
     if (!core->currentVM) return; //no vm
 
-    py_GlobalRef py_bdr = py_getglobal(N.BDR);
-    if (!py_bdr) return;
-    py_push(py_bdr);
-    py_pushnil();
-    py_Ref py_row = py_retval();
-    py_newint(py_row, row);
-    py_push(py_row);
-    if (!py_vectorcall(1, 0))
-    {
-        py_throw_error(core, "BORDER running error!");
-    }
+    call_callback(core, N.BDR, row, "BORDER running error!");
 }
 void callback_menu(tic_mem* tic, s32 index, void* data)
 {
     tic_core* core = (tic_core*)tic;
     if (!core->currentVM) return; //no vm
 
-    py_GlobalRef py_menu = py_getglobal(N.MENU);
-    if (!py_menu) return;
-    py_push(py_menu);
-    py_pushnil();
-    py_Ref py_idx = py_retval();
-    py_newint(py_idx, index);
-    py_push(py_idx);
-    if (!py_vectorcall(1, 0))
-    {
-        py_throw_error(core, "MENU running error!");
-    }
+    call_callback(core, N.MENU, index, "MENU running error!");
 }
 
 static const char* const PythonKeywords[] =
@@ -749,7 +749,7 @@ s7_pointer scheme_fset(s7_scheme* sc, s7_pointer args)
 
 s7_pointer scheme_fft(s7_scheme* sc, s7_pointer args)
 {
-    // fft(int start_freq, int end_freq=-1) -> float_value
+    // fft(int start_freq, int end_freq=-1, bool bands=false) -> float_value
     tic_core* core = getSchemeCore(sc);
     tic_mem* tic = (tic_mem*)core;
 
@@ -757,19 +757,78 @@ s7_pointer scheme_fft(s7_scheme* sc, s7_pointer args)
     const s32 start_freq = argn > 0 ? s7_integer(s7_car(args)) : -1;
     const s32 end_freq = argn > 1 ? s7_integer(s7_cadr(args)) : -1;
 
-    return s7_make_real(sc, core->api.fft(tic, start_freq, end_freq));
+    const bool bands = argn > 2 ? s7_boolean(sc, s7_caddr(args)) : false;
+
+    return s7_make_real(sc, core->api.fft(tic, start_freq, end_freq, bands));
 }
 
 s7_pointer scheme_ffts(s7_scheme* sc, s7_pointer args)
 {
-    // ffts(int start_freq, int end_freq=-1) -> float_value
+    // ffts(int start_freq, int end_freq=-1, bool bands=false) -> float_value
     tic_core* core = getSchemeCore(sc);
     tic_mem* tic = (tic_mem*)core;
     const int argn = s7_list_length(sc, args);
     const s32 start_freq = argn > 0 ? s7_integer(s7_car(args)) : -1;
     const s32 end_freq = argn > 1 ? s7_integer(s7_cadr(args)) : -1;
 
-    return s7_make_real(sc, core->api.ffts(tic, start_freq, end_freq));
+    const bool bands = argn > 2 ? s7_boolean(sc, s7_caddr(args)) : false;
+
+    return s7_make_real(sc, core->api.ffts(tic, start_freq, end_freq, bands));
+}
+
+// bytes of a byte-vector or a string, used in place
+static const u8* getSchemeBytes(s7_pointer arg, s32* size)
+{
+    if (s7_is_byte_vector(arg))
+    {
+        *size = (s32)s7_vector_length(arg);
+        return s7_byte_vector_elements(arg);
+    }
+
+    if (s7_is_string(arg))
+    {
+        *size = (s32)s7_string_length(arg);
+        return (const u8*)s7_string(arg);
+    }
+
+    return NULL;
+}
+
+s7_pointer scheme_memput(s7_scheme* sc, s7_pointer args)
+{
+    // memput(dest data)
+    tic_core* core = getSchemeCore(sc); tic_mem* tic = (tic_mem*)core;
+    const s32 dest = s7_integer(s7_car(args));
+
+    s32 size = 0;
+    const u8* data = getSchemeBytes(s7_cadr(args), &size);
+
+    if (!data)
+        return s7_wrong_type_arg_error(sc, "t80::memput", 2, s7_cadr(args), "a byte-vector or a string");
+
+    core->api.memput(tic, dest, data, size);
+    return s7_nil(sc);
+}
+
+s7_pointer scheme_blit(s7_scheme* sc, s7_pointer args)
+{
+    // blit(x y w h data packed=false)
+    tic_core* core = getSchemeCore(sc); tic_mem* tic = (tic_mem*)core;
+    const int argn = s7_list_length(sc, args);
+    const s32 x = s7_integer(s7_list_ref(sc, args, 0));
+    const s32 y = s7_integer(s7_list_ref(sc, args, 1));
+    const s32 w = s7_integer(s7_list_ref(sc, args, 2));
+    const s32 h = s7_integer(s7_list_ref(sc, args, 3));
+    const bool packed = argn > 5 ? s7_boolean(sc, s7_list_ref(sc, args, 5)) : false;
+
+    s32 size = 0;
+    const u8* data = getSchemeBytes(s7_list_ref(sc, args, 4), &size);
+
+    if (!data)
+        return s7_wrong_type_arg_error(sc, "t80::blit", 5, s7_list_ref(sc, args, 4), "a byte-vector or a string");
+
+    core->api.blit(tic, x, y, w, h, data, size, packed);
+    return s7_nil(sc);
 }
 
 static void initAPI(tic_core* core)
@@ -795,12 +854,85 @@ static void initAPI(tic_core* core)
     }
 }
 
+// global callbacks, looked up once per frame, protected from the GC
+// while cached, NULL if the script doesn't define them
+typedef struct
+{
+    s7_pointer func;
+    s7_int loc;
+} SchemeCallback;
+
+// kept in core->scriptCallbacks next to the VM they belong to
+typedef struct
+{
+    SchemeCallback tic;
+    SchemeCallback scn;
+    SchemeCallback bdr;
+    SchemeCallback menu;
+} SchemeCallbacks;
+
+static void freeCallbacks(s7_scheme* sc, SchemeCallbacks* callbacks)
+{
+    SchemeCallback* all[] = {&callbacks->tic, &callbacks->scn, &callbacks->bdr, &callbacks->menu};
+
+    for (s32 i = 0; i < COUNT_OF(all); i++)
+        if (all[i]->func)
+            s7_gc_unprotect_at(sc, all[i]->loc);
+
+    free(callbacks);
+}
+
+// keeps the protected slot while the binding still holds the same procedure
+static void updateCallback(s7_scheme* sc, SchemeCallback* callback, const char* name)
+{
+    s7_pointer func = NULL;
+
+    if (s7_is_defined(sc, name))
+    {
+        func = s7_name_to_value(sc, name);
+
+        if (!s7_is_procedure(func))
+            func = NULL;
+    }
+
+    if (func == callback->func)
+        return;
+
+    if (callback->func)
+        s7_gc_unprotect_at(sc, callback->loc);
+
+    *callback = func ? (SchemeCallback){func, s7_gc_protect(sc, func)} : (SchemeCallback){0};
+}
+
+// TIC is looked up right before it runs, the others after BOOT
+// and after every TIC, which may (re)define them
+static void resolveCallbacks(tic_core* core)
+{
+    s7_scheme* sc = core->currentVM;
+    SchemeCallbacks* callbacks = core->scriptCallbacks;
+
+    updateCallback(sc, &callbacks->scn, SCN_FN);
+    updateCallback(sc, &callbacks->bdr, BDR_FN);
+    updateCallback(sc, &callbacks->menu, MENU_FN);
+
+    core->callbacks = tic_script_probed
+        | (callbacks->scn.func ? tic_script_scn : 0)
+        | (callbacks->bdr.func ? tic_script_bdr : 0)
+        | (callbacks->menu.func ? tic_script_menu : 0);
+}
+
 static void closeScheme(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
 
     if(core->currentVM)
     {
+        if (core->scriptCallbacks)
+        {
+            freeCallbacks(core->currentVM, core->scriptCallbacks);
+            core->scriptCallbacks = NULL;
+        }
+
         s7_free(core->currentVM);
         core->currentVM = NULL;
     }
@@ -846,6 +978,9 @@ static bool initScheme(tic_mem* tic, const char* code)
     tic_core* core = (tic_core*)tic;
     closeScheme(tic);
 
+    if (!(core->scriptCallbacks = calloc(1, sizeof(SchemeCallbacks))))
+        return false;
+
     s7_scheme* sc = core->currentVM = s7_init();
     initAPI(core);
 
@@ -875,11 +1010,15 @@ static void callSchemeTick(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
     s7_scheme* sc = core->currentVM;
+    SchemeCallbacks* callbacks = core->scriptCallbacks;
 
-    const bool isTicDefined = s7_is_defined(sc, ticFnName);
-    if (isTicDefined) {
-        s7_call(sc, s7_name_to_value(sc, ticFnName), s7_nil(sc));
+    updateCallback(sc, &callbacks->tic, TIC_FN);
+
+    if (callbacks->tic.func) {
+        s7_call(sc, callbacks->tic.func, s7_nil(sc));
     }
+
+    resolveCallbacks(core);
 }
 
 static void callSchemeBoot(tic_mem* tic)
@@ -892,42 +1031,38 @@ static void callSchemeBoot(tic_mem* tic)
     if (isBootDefined) {
         s7_call(sc, s7_name_to_value(sc, "BOOT"), s7_nil(sc));
     }
+
+    resolveCallbacks(core);
 }
 
-static void callSchemeScanline(tic_mem* tic, s32 row, void* data)
+static void callSchemeIntCallback(tic_mem* tic, s32 value, s7_pointer func)
 {
     tic_core* core = (tic_core*)tic;
     s7_scheme* sc = core->currentVM;
 
-    static const char* scnFnName = "SCN";
-    const bool isScnDefined = s7_is_defined(sc, scnFnName);
-    if (isScnDefined) {
-        s7_call(sc, s7_name_to_value(sc, scnFnName), s7_cons(sc, s7_make_integer(sc, row), s7_nil(sc)));
+    if (func) {
+        s7_call(sc, func, s7_cons(sc, s7_make_integer(sc, value), s7_nil(sc)));
     }
 }
 
-static void callSchemeBorder(tic_mem* tic, s32 row, void* data)
+static inline SchemeCallbacks* getCallbacks(tic_mem* tic)
 {
-    tic_core* core = (tic_core*)tic;
-    s7_scheme* sc = core->currentVM;
+    return ((tic_core*)tic)->scriptCallbacks;
+}
 
-    static const char* bdrFnName = "BDR";
-    bool isBdrDefined = s7_is_defined(sc, bdrFnName);
-    if (isBdrDefined) {
-        s7_call(sc, s7_name_to_value(sc, bdrFnName), s7_cons(sc, s7_make_integer(sc, row), s7_nil(sc)));
-    }
+static void callSchemeScanline(tic_mem* tic, s32 row, void* data)
+{
+    callSchemeIntCallback(tic, row, getCallbacks(tic)->scn.func);
 }
 
-static void callSchemeMenu(tic_mem* tic, s32 index, void* data)
+static void callSchemeBorder(tic_mem* tic, s32 row, void* data)
 {
-    tic_core* core = (tic_core*)tic;
-    s7_scheme* sc = core->currentVM;
+    callSchemeIntCallback(tic, row, getCallbacks(tic)->bdr.func);
+}
 
-    static const char* menuFnName = "MENU";
-    bool isMenuDefined = s7_is_defined(sc, menuFnName);
-    if (isMenuDefined) {
-        s7_call(sc, s7_name_to_value(sc, menuFnName), s7_cons(sc, s7_make_integer(sc, index), s7_nil(sc)));
-    }
+static void callSchemeMenu(tic_mem* tic, s32 index, void* data)
+{
+    callSchemeIntCallback(tic, index, getCallbacks(tic)->menu.func);
 }
 
 static const char* const SchemeKeywords [] =
@@ -1043,6 +1178,9 @@ void evalScheme(tic_mem* tic, const char* code) {
     }
 
     s7_eval_c_string(sc, code);
+
+    // eval may (re)define callbacks
+    resolveCallbacks(core);
 }
 
 static const char* SchemeAPIKeywords[] = {
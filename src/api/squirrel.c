@@ -1540,17 +1540,23 @@ static SQInteger squirrel_fft(HSQUIRRELVM vm)
     {
         double start_freq = getSquirrelNumber(vm, 2);
         double end_freq = -1;
+        SQBool bands = SQFalse;
 
         if (top >= 3)
         {
             end_freq = getSquirrelNumber(vm, 3);
         }
 
-        sq_pushfloat(vm, (SQFloat)(core->api.fft(tic, start_freq, end_freq)));
+        if (top >= 4)
+        {
+            sq_getbool(vm, 4, &bands);
+        }
+
+        sq_pushfloat(vm, (SQFloat)(core->api.fft(tic, start_freq, end_freq, bands)));
         return 1;
     }
 
-    sq_throwerror(vm, "invalid params, fft(start_freq, end_freq)\n");
+    sq_throwerror(vm, "invalid params, fft(start_freq, end_freq, bands)\n");
 
     return 0;
 }
@@ -1566,21 +1572,168 @@ static SQInteger squirrel_ffts(HSQUIRRELVM vm)
     {
         double start_freq = getSquirrelNumber(vm, 2);
         double end_freq = -1;
+        SQBool bands = SQFalse;
 
         if (top >= 3)
         {
             end_freq = getSquirrelNumber(vm, 3);
         }
 
-        sq_pushfloat(vm, (SQFloat)(core->api.ffts(tic, start_freq, end_freq)));
+        if (top >= 4)
+        {
+            sq_getbool(vm, 4, &bands);
+        }
+
+        sq_pushfloat(vm, (SQFloat)(core->api.ffts(tic, start_freq, end_freq, bands)));
         return 1;
     }
 
-    sq_throwerror(vm, "invalid params, ffts(start_freq, end_freq)\n");
+    sq_throwerror(vm, "invalid params, ffts(start_freq, end_freq, bands)\n");
 
     return 0;
 }
 
+// bytes of a string or a blob, used in place
+static const u8* getSquirrelBytes(HSQUIRRELVM vm, s32 index, s32* size)
+{
+    if (sq_gettype(vm, index) == OT_STRING)
+    {
+        const SQChar* str = NULL;
+        SQInteger len = 0;
+        sq_getstringandsize(vm, index, &str, &len);
+
+        *size = (s32)len;
+        return (const u8*)str;
+    }
+
+    SQUserPointer ptr = NULL;
+
+    if (SQ_SUCCEEDED(sqstd_getblob(vm, index, &ptr)))
+    {
+        *size = (s32)sqstd_getblobsize(vm, index);
+        return ptr;
+    }
+
+    return NULL;
+}
+
+static SQInteger squirrel_memput(HSQUIRRELVM vm)
+{
+    SQInteger top = sq_gettop(vm);
+
+    if(top == 3)
+    {
+        s32 dest = getSquirrelNumber(vm, 2);
+
+        s32 size = 0;
+        const u8* data = getSquirrelBytes(vm, 3, &size);
+
+        if(data)
+        {
+            tic_core* core = getSquirrelCore(vm); tic_mem* tic = (tic_mem*)core;
+
+            core->api.memput(tic, dest, data, size);
+            return 0;
+        }
+    }
+
+    return sq_throwerror(vm, "invalid params, memput(dest,data)\n");
+}
+
+static SQInteger squirrel_blit(HSQUIRRELVM vm)
+{
+    SQInteger top = sq_gettop(vm);
+
+    if(top >= 6)
+    {
+        s32 x = getSquirrelNumber(vm, 2);
+        s32 y = getSquirrelNumber(vm, 3);
+        s32 w = getSquirrelNumber(vm, 4);
+        s32 h = getSquirrelNumber(vm, 5);
+
+        s32 size = 0;
+        const u8* data = getSquirrelBytes(vm, 6, &size);
+
+        bool packed = false;
+
+        if(top >= 7)
+        {
+            SQBool b = SQFalse;
+            sq_getbool(vm, 7, &b);
+            packed = (b != SQFalse);
+        }
+
+        if(data)
+        {
+            tic_core* core = getSquirrelCore(vm); tic_mem* tic = (tic_mem*)core;
+
+            core->api.blit(tic, x, y, w, h, data, size, packed);
+            return 0;
+        }
+    }
+
+    return sq_throwerror(vm, "invalid params, blit(x,y,w,h,data,packed=false)\n");
+}
+
+// the ram userdata keeps a pointer to tic_ram, so its delegates don't need the core lookup
+static u8* getSquirrelRam(HSQUIRRELVM vm, s32 index)
+{
+    SQUserPointer ptr = NULL;
+    sq_getuserdata(vm, index, &ptr, NULL);
+
+    return ptr ? *(u8**)ptr : NULL;
+}
+
+static SQInteger squirrel_ram_get(HSQUIRRELVM vm)
+{
+    u8* ram = getSquirrelRam(vm, 1);
+    SQInteger address;
+
+    if (SQ_FAILED(sq_getinteger(vm, 2, &address)) || address < 0 || address >= TIC_RAM_SIZE)
+        return sq_throwerror(vm, "ram address out of range");
+
+    sq_pushinteger(vm, ram[address]);
+    return 1;
+}
+
+static SQInteger squirrel_ram_set(HSQUIRRELVM vm)
+{
+    u8* ram = getSquirrelRam(vm, 1);
+    SQInteger address, value;
+
+    if (SQ_FAILED(sq_getinteger(vm, 2, &address)) || address < 0 || address >= TIC_RAM_SIZE)
+        return sq_throwerror(vm, "ram address out of range");
+
+    if (SQ_FAILED(sq_getinteger(vm, 3, &value)))
+        return sq_throwerror(vm, "invalid parameters, ram[address] = value");
+
+    ram[address] = (u8)value;
+    return 0;
+}
+
+// ram[address] reads and writes RAM bytes in place, without the peek/poke dispatch
+static void registerSquirrelRamView(tic_core* core)
+{
+    HSQUIRRELVM vm = core->currentVM;
+
+    sq_pushroottable(vm);
+    sq_pushstring(vm, "ram", -1);
+
+    *(u8**)sq_newuserdata(vm, sizeof(u8*)) = (u8*)core->memory.ram;
+
+    sq_newtable(vm);
+    sq_pushstring(vm, "_get", -1);
+    sq_newclosure(vm, squirrel_ram_get, 0);
+    sq_newslot(vm, -3, SQFalse);
+    sq_pushstring(vm, "_set", -1);
+    sq_newclosure(vm, squirrel_ram_set, 0);
+    sq_newslot(vm, -3, SQFalse);
+    sq_setdelegate(vm, -2);
+
+    sq_newslot(vm, -3, SQTrue);
+    sq_poptop(vm); // remove root table.
+}
+
 static SQInteger squirrel_dofile(HSQUIRRELVM vm)
 {
     return sq_throwerror(vm, "unknown method: \"dofile\"\n");
@@ -1626,16 +1779,122 @@ static void initAPI(tic_core* core)
     registerSquirrelFunction(core, squirrel_dofile, "dofile");
     registerSquirrelFunction(core, squirrel_loadfile, "loadfile");
 
+    registerSquirrelRamView(core);
+
     sq_enabledebuginfo(vm, SQTrue);
 
 }
 
+// global callbacks, looked up once per frame instead of on every call,
+// kept in core->scriptCallbacks next to the VM they belong to
+typedef struct
+{
+    HSQOBJECT tic;
+    HSQOBJECT scn;
+    HSQOBJECT scanline;
+    HSQOBJECT bdr;
+    HSQOBJECT menu;
+    HSQOBJECT ovr;
+} SquirrelCallbacks;
+
+static SquirrelCallbacks* createCallbacks()
+{
+    SquirrelCallbacks* callbacks = malloc(sizeof(SquirrelCallbacks));
+
+    if(callbacks)
+    {
+        HSQOBJECT* all[] = {&callbacks->tic, &callbacks->scn, &callbacks->scanline, &callbacks->bdr, &callbacks->menu, &callbacks->ovr};
+
+        for(s32 i = 0; i < COUNT_OF(all); i++)
+            sq_resetobject(all[i]);
+    }
+
+    return callbacks;
+}
+
+static void freeCallbacks(HSQUIRRELVM vm, SquirrelCallbacks* callbacks)
+{
+    HSQOBJECT* all[] = {&callbacks->tic, &callbacks->scn, &callbacks->scanline, &callbacks->bdr, &callbacks->menu, &callbacks->ovr};
+
+    for(s32 i = 0; i < COUNT_OF(all); i++)
+        sq_release(vm, all[i]);
+
+    free(callbacks);
+}
+
+static HSQOBJECT getCallback(HSQUIRRELVM vm, const char* name)
+{
+    HSQOBJECT obj;
+    sq_resetobject(&obj);
+
+    sq_pushroottable(vm);
+    sq_pushstring(vm, name, -1);
+
+    if(SQ_SUCCEEDED(sq_get(vm, -2)))
+    {
+        SQObjectType type = sq_gettype(vm, -1);
+
+        if(type == OT_CLOSURE || type == OT_NATIVECLOSURE)
+        {
+            sq_getstackobj(vm, -1, &obj);
+            sq_addref(vm, &obj);
+        }
+
+        sq_pop(vm, 2); // value and root table
+    }
+    else sq_poptop(vm);
+
+    return obj;
+}
+
+static void updateCallback(HSQUIRRELVM vm, HSQOBJECT* func, const char* name)
+{
+    sq_release(vm, func);
+    *func = getCallback(vm, name);
+}
+
+// TIC is looked up right before it runs
+static void resolveTickCallbacks(tic_core* core)
+{
+    HSQUIRRELVM vm = core->currentVM;
+    SquirrelCallbacks* callbacks = core->scriptCallbacks;
+
+    updateCallback(vm, &callbacks->tic, TIC_FN);
+#if defined(BUILD_DEPRECATED)
+    updateCallback(vm, &callbacks->ovr, OVR_FN);
+#endif
+}
+
+// the others after BOOT and after every TIC, which may (re)assign them
+static void resolveCallbacks(tic_core* core)
+{
+    HSQUIRRELVM vm = core->currentVM;
+    SquirrelCallbacks* callbacks = core->scriptCallbacks;
+
+    updateCallback(vm, &callbacks->scn, SCN_FN);
+    // old scanline() name
+    updateCallback(vm, &callbacks->scanline, "scanline");
+    updateCallback(vm, &callbacks->bdr, BDR_FN);
+    updateCallback(vm, &callbacks->menu, MENU_FN);
+
+    core->callbacks = tic_script_probed
+        | (sq_isnull(callbacks->scn) && sq_isnull(callbacks->scanline) ? 0 : tic_script_scn)
+        | (sq_isnull(callbacks->bdr) ? 0 : tic_script_bdr)
+        | (sq_isnull(callbacks->menu) ? 0 : tic_script_menu);
+}
+
 static void closeSquirrel(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
 
     if(core->currentVM)
     {
+        if(core->scriptCallbacks)
+        {
+            freeCallbacks(core->currentVM, core->scriptCallbacks);
+            core->scriptCallbacks = NULL;
+        }
+
         sq_close(core->currentVM);
         core->currentVM = NULL;
     }
@@ -1647,6 +1906,9 @@ static bool initSquirrel(tic_mem* tic, const char* code)
 
     closeSquirrel(tic);
 
+    if(!(core->scriptCallbacks = createCallbacks()))
+        return false;
+
     HSQUIRRELVM vm = core->currentVM = sq_open(100);
     squirrel_open_builtins(vm);
 
@@ -1697,6 +1959,27 @@ static void errorReport(tic_mem* tic)
     sq_pop(vm, 3); // remove string, error and root table.
 }
 
+// calls a cached closure with the root table as `this`, false on error
+static bool callSquirrelObject(tic_mem* tic, HSQOBJECT func, const SQInteger* value)
+{
+    HSQUIRRELVM vm = ((tic_core*)tic)->currentVM;
+
+    sq_pushobject(vm, func);
+    sq_pushroottable(vm);
+
+    if(value)
+        sq_pushinteger(vm, *value);
+
+    bool done = SQ_SUCCEEDED(sq_call(vm, value ? 2 : 1, SQFalse, SQTrue));
+
+    if(done)
+        sq_poptop(vm); // closure
+    else
+        errorReport(tic);
+
+    return done;
+}
+
 static void callSquirrelTick(tic_mem* tic)
 {
     tic_core* core = (tic_core*)tic;
@@ -1705,43 +1988,30 @@ static void callSquirrelTick(tic_mem* tic)
 
     if(vm)
     {
-        sq_pushroottable(vm);
-        sq_pushstring(vm, TIC_FN, -1);
+        SquirrelCallbacks* callbacks = core->scriptCallbacks;
 
-        if (SQ_SUCCEEDED(sq_get(vm, -2)))
+        resolveTickCallbacks(core);
+
+        if(!sq_isnull(callbacks->tic))
         {
-            sq_pushroottable(vm);
-            if(SQ_FAILED(sq_call(vm, 1, SQFalse, SQTrue)))
-            {
-                errorReport(tic);
+            if(!callSquirrelObject(tic, callbacks->tic, NULL))
                 return;
-            }
 
 #if defined(BUILD_DEPRECATED)
             // call OVR() callback for backward compatibility
+            if(!sq_isnull(callbacks->ovr))
             {
-                sq_pushroottable(vm);
-                sq_pushstring(vm, OVR_FN, -1);
-
-                if(SQ_SUCCEEDED(sq_get(vm, -2)))
+                OVR(core)
                 {
-                    OVR(core)
-                    {
-                        sq_pushroottable(vm);
-
-                        if(SQ_FAILED(sq_call(vm, 1, SQFalse, SQTrue)))
-                        {
-                            errorReport(tic);
-                        }
-                    }
+                    callSquirrelObject(tic, callbacks->ovr, NULL);
                 }
-                else sq_poptop(vm);
             }
 #endif
+
+            resolveCallbacks(core);
         }
         else
         {
-            sq_pop(vm, 1);
             if (core->data)
                 core->data->error(core->data->data, "'function TIC()...' isn't found :(");
         }
@@ -1756,67 +2026,57 @@ static void callSquirrelBoot(tic_mem* tic)
 
     if(vm)
     {
-        sq_pushroottable(vm);
-        sq_pushstring(vm, BOOT_FN, -1);
+        HSQOBJECT boot = getCallback(vm, BOOT_FN);
 
-        if (SQ_SUCCEEDED(sq_get(vm, -2)))
+        if(!sq_isnull(boot))
         {
-            sq_pushroottable(vm);
-            if(SQ_FAILED(sq_call(vm, 1, SQFalse, SQTrue)))
-            {
-                errorReport(tic);
-                return;
-            }
+            callSquirrelObject(tic, boot, NULL);
+            sq_release(vm, &boot);
         }
+
+        resolveCallbacks(core);
     }
 }
 
-static void callSquirrelIntCallback(tic_mem* tic, s32 value, void* data, const char* name)
+static void callSquirrelIntCallback(tic_mem* tic, s32 value, const HSQOBJECT* func)
 {
-    tic_core* core = (tic_core*)tic;
-    HSQUIRRELVM vm = core->currentVM;
-
-    if (vm)
+    if (!sq_isnull(*func))
     {
-        sq_pushroottable(vm);
-        sq_pushstring(vm, name, -1);
-        if (SQ_SUCCEEDED(sq_get(vm, -2)))
-        {
-            sq_pushroottable(vm);
-            sq_pushinteger(vm, value);
-
-            if(SQ_FAILED(sq_call(vm, 2, SQFalse, SQTrue)))
-            {
-                sq_getlasterror(vm);
-                sq_tostring(vm, -1);
-
-                const SQChar* errorString = "unknown error";
-                sq_getstring(vm, -1, &errorString);
-                if (core->data)
-                    core->data->error(core->data->data, errorString);
-                sq_pop(vm, 3); // error string, error and root table
-            }
-        }
-        else sq_poptop(vm);
+        SQInteger arg = value;
+        callSquirrelObject(tic, *func, &arg);
     }
 }
 
 static void callSquirrelScanline(tic_mem* tic, s32 row, void* data)
 {
-    callSquirrelIntCallback(tic, row, data, SCN_FN);
+    tic_core* core = (tic_core*)tic;
+    SquirrelCallbacks* callbacks = core->scriptCallbacks;
 
-    // try to call old scanline
-    callSquirrelIntCallback(tic, row, data, "scanline");
+    if (core->currentVM)
+    {
+        callSquirrelIntCallback(tic, row, &callbacks->scn);
+
+        // try to call old scanline
+        callSquirrelIntCallback(tic, row, &callbacks->scanline);
+    }
 }
 
 static void callSquirrelBorder(tic_mem* tic, s32 row, void* data)
 {
-    callSquirrelIntCallback(tic, row, data, BDR_FN);
+    tic_core* core = (tic_core*)tic;
+    SquirrelCallbacks* callbacks = core->scriptCallbacks;
+
+    if (core->currentVM)
+        callSquirrelIntCallback(tic, row, &callbacks->bdr);
 }
 
 static void callSquirrelMenu(tic_mem* tic, s32 index, void* data)
 {
-    callSquirrelIntCallback(tic, index, data, MENU_FN);
+    tic_core* core = (tic_core*)tic;
+    SquirrelCallbacks* callbacks = core->scriptCallbacks;
+
+    if (core->currentVM)
+        callSquirrelIntCallback(tic, index, &callbacks->menu);
 }
 
 static const char* const SquirrelKeywords [] =
@@ -1918,6 +2178,9 @@ void evalSquirrel(tic_mem* tic, const char* code) {
     }
 
     sq_settop(vm, 0);
+
+    // eval may (re)define callbacks
+    resolveCallbacks(core);
 }
 
 static const u8 DemoRom[] =
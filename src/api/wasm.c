@@ -46,12 +46,6 @@ typedef float           f32;
 
 static const char TicCore[] = "_TIC80";
 
-IM3Function BDR_function;
-IM3Function SCN_function;
-IM3Function TIC_function;
-IM3Function BOOT_function;
-IM3Function MENU_function;
-
 #define FATAL(msg, ...) { printf("Error: [Fatal] " msg "\n", ##__VA_ARGS__); goto _onfatal; }
 #define WASM_STACK_SIZE 64*1024
 
@@ -879,6 +873,47 @@ m3ApiRawFunction(wasmtic_memcpy)
     m3ApiSuccess();
 }
 
+// the source can be anywhere in the linear memory, not only in the RAM part memcpy is limited to
+m3ApiRawFunction(wasmtic_memput)
+{
+    m3ApiGetArg      (int32_t, dest);
+    m3ApiGetArgMem   (const u8*, src);
+    m3ApiGetArg      (int32_t, length);
+
+    if(length < 0)
+        m3ApiTrap("invalid memput length");
+
+    m3ApiCheckMem(src, length);
+
+    tic_core* core = getWasmCore(runtime); tic_mem* tic = (tic_mem*)core;
+
+    core->api.memput(tic, dest, src, length);
+
+    m3ApiSuccess();
+}
+
+m3ApiRawFunction(wasmtic_blit)
+{
+    m3ApiGetArg      (int32_t, x);
+    m3ApiGetArg      (int32_t, y);
+    m3ApiGetArg      (int32_t, w);
+    m3ApiGetArg      (int32_t, h);
+    m3ApiGetArgMem   (const u8*, data);
+    m3ApiGetArg      (int32_t, length);
+    m3ApiGetArg      (int8_t, packed);
+
+    if(length < 0)
+        m3ApiTrap("invalid blit length");
+
+    m3ApiCheckMem(data, length);
+
+    tic_core* core = getWasmCore(runtime); tic_mem* tic = (tic_mem*)core;
+
+    core->api.blit(tic, x, y, w, h, data, length, packed);
+
+    m3ApiSuccess();
+}
+
 
 m3ApiRawFunction(wasmtic_exit)
 {
@@ -1005,6 +1040,7 @@ m3ApiRawFunction(wasmtic_mouse)
 M3Result linkTicAPI(IM3Module module)
 {
     M3Result result = m3Err_none;
+    _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "blit",    "v(iiii*ii)",    &wasmtic_blit)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "btn",     "i(i)",          &wasmtic_btn)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "btnp",    "i(iii)",        &wasmtic_btnp)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "clip",    "v(iiii)",       &wasmtic_clip)));
@@ -1023,6 +1059,7 @@ M3Result linkTicAPI(IM3Module module)
     // TODO: needs a lot of help for all the optional arguments
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "map",     "v(iiiiiiiiii)", &wasmtic_map)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "memcpy",  "v(iii)",        &wasmtic_memcpy)));
+    _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "memput",  "v(i*i)",        &wasmtic_memput)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "memset",  "v(iii)",        &wasmtic_memset)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "mget",    "i(ii)",         &wasmtic_mget)));
     _   (SuppressLookupFailure (m3_LinkRawFunction (module, "env", "mset",    "v(iii)",        &wasmtic_mset)));
@@ -1056,20 +1093,100 @@ _catch:
   return result;
 }
 
-void deinitWasmRuntime( IM3Runtime runtime )
+typedef enum
+{
+    WasmTic,
+    WasmBoot,
+    WasmScn,
+    WasmBdr,
+    WasmMenu,
+
+    WasmExportsCount,
+} WasmExport;
+
+static const char* const WasmExportNames[WasmExportsCount] = {TIC_FN, BOOT_FN, SCN_FN, BDR_FN, MENU_FN};
+
+static IM3Function Wasm3Exports[WasmExportsCount];
+
+// creates the runtime in core->currentVM and returns the base of its linear memory
+static u8* wasm3Create(tic_core* core)
 {
-    dbg("Denitializing wasm runtime\n");
-    if (runtime == NULL)
+    dbg("Initializing WASM3 runtime %p\n", core);
+
+    IM3Environment env = m3_NewEnvironment ();
+    if(!env)
+        return NULL;
+
+    IM3Runtime runtime = m3_NewRuntime (env, WASM_STACK_SIZE, core);
+    if(!runtime)
     {
-        printf("WARNING deinitWasm of null");
-        return;
+        m3_FreeEnvironment (env);
+        return NULL;
+    }
+
+    runtime->memory.maxPages = TIC_WASM_PAGE_COUNT;
+    ResizeMemory(runtime, TIC_WASM_PAGE_COUNT);
+
+    core->currentVM = runtime;
+
+    return m3_GetMemory(runtime, NULL, 0);
+}
+
+// the module's data segments are written over the mapped RAM, returns an error or NULL
+static const char* wasm3Instantiate(tic_core* core, const void* binary, s32 size)
+{
+    IM3Runtime runtime = core->currentVM;
+
+    IM3Module module;
+    M3Result result = m3_ParseModule (runtime->environment, &module, binary, size);
+    if (result)
+        return result;
+
+    result = m3_LoadModule (runtime, module);
+    if (result)
+    {
+        m3_FreeModule (module);
+        return result;
+    }
+
+    result = linkTicAPI(runtime->modules);
+    if (result)
+        return result;
+
+    for(s32 i = 0; i < WasmExportsCount; i++)
+    {
+        Wasm3Exports[i] = NULL;
+        m3_FindFunction (&Wasm3Exports[i], runtime, WasmExportNames[i]);
     }
-    IM3Environment env = runtime -> environment;
-    printf("deiniting env %p\n", env);
 
-    tic_core* tic = getWasmCore(runtime);
+    // translate every function now instead of on its first call in the middle of a frame
+    return m3_CompileModule (runtime->modules);
+}
+
+static void wasm3Free(tic_core* core)
+{
+    IM3Runtime runtime = core->currentVM;
+    IM3Environment env = runtime->environment;
+
+    dbg("Deinitializing wasm runtime %p\n", env);
+
     m3_FreeRuntime (runtime);
     m3_FreeEnvironment (env);
+
+    for(s32 i = 0; i < WasmExportsCount; i++)
+        Wasm3Exports[i] = NULL;
+}
+
+static bool wasm3Exported(tic_core* core, WasmExport func)
+{
+    return Wasm3Exports[func] != NULL;
+}
+
+static const char* wasm3Call(tic_core* core, WasmExport func, const s32* arg)
+{
+    return arg
+        ? m3_CallV(Wasm3Exports[func], *arg)
+        : m3_CallV(Wasm3Exports[func]);
 }
 
 static void closeWasm(tic_mem* tic)
@@ -1090,10 +1207,10 @@ static void closeWasm(tic_mem* tic)
         // for an entirely different VM.  This sequencing matters a lot
         // less if one assumes (like before) that all the VMs share a
         // common memory area.
-        u8* low_ram =  (u8*)core->memory.base_ram;
-        u8* wasm_ram = m3_GetMemory(core->currentVM, NULL, 0);
-        memcpy(low_ram, wasm_ram, TIC_RAM_SIZE);
-        deinitWasmRuntime(core->currentVM);
+        if(core->memory.ram)
+            memcpy(core->memory.base_ram, core->memory.ram, TIC_RAM_SIZE);
+
+        wasm3Free(core);
         core->currentVM = NULL;
         core->memory.ram = NULL;
     }
@@ -1115,31 +1232,19 @@ static bool initWasm(tic_mem* tic, const char* code)
 {
     // closeWasm(tic);
     tic_core* core = (tic_core*)tic;
-    dbg("Initializing WASM3 runtime %p\n", core);
 
-    IM3Environment env = m3_NewEnvironment ();
-    if(!env)
-    {
-        core->data->error(core->data->data, "Unable to init WASM env");
-        return false;
-    }
-    IM3Runtime runtime = m3_NewRuntime (env, WASM_STACK_SIZE, core);
-    if(!runtime)
+    u8* wasm_ram = wasm3Create(core);
+    if(!wasm_ram)
     {
         core->data->error(core->data->data, "Unable to init WASM runtime");
         return false;
     }
 
-    runtime->memory.maxPages = TIC_WASM_PAGE_COUNT;
-    ResizeMemory(runtime, TIC_WASM_PAGE_COUNT);
-
+    // tic_ram is mapped to the start of the linear memory
     u8* low_ram =  (u8*)core->memory.ram;
-    u8* wasm_ram = m3_GetMemory(runtime, NULL, 0);
     memcpy(wasm_ram, low_ram, TIC_RAM_SIZE);
     core->memory.ram = (tic_ram*)wasm_ram;
 
-    core->currentVM = runtime;
-
     // TODO: if compiling from WAT is an option where should this
     // code go?
 
@@ -1159,104 +1264,67 @@ static bool initWasm(tic_mem* tic, const char* code)
     // int fsize = TIC_BINARY_SIZE;
     int fsize = tic->cart.binary.size;
 
-    IM3Module module;
-    M3Result result = m3_ParseModule (runtime->environment, &module, wasmcode, fsize);
-
-    if (result){
-        core->data->error(core->data->data, result);
-        return false;
-    }
-
-    result = m3_LoadModule (runtime, module);
-    if (result){
-        core->data->error(core->data->data, result);
-        return false;
-    }
-
-    result = linkTicAPI(runtime->modules);
-    if (result)
+    const char* error = wasm3Instantiate(core, wasmcode, fsize);
+    if (error)
     {
-        core->data->error(core->data->data, result);
+        core->data->error(core->data->data, error);
         return false;
     }
 
-    m3_FindFunction (&BDR_function, runtime, BDR_FN);
-    m3_FindFunction (&SCN_function, runtime, SCN_FN);
-    m3_FindFunction (&BOOT_function, runtime, BOOT_FN);
-    m3_FindFunction (&MENU_function, runtime, MENU_FN);
-    result = m3_FindFunction (&TIC_function, runtime, TIC_FN);
-
-    if (result)
+    if (!wasm3Exported(core, WasmTic))
     {
         core->data->error(core->data->data, "Error: WASM must export a TIC function.");
         return false;
     }
 
+    // exports are fixed once the module is loaded
+    core->callbacks = tic_script_probed
+        | (wasm3Exported(core, WasmScn) ? tic_script_scn : 0)
+        | (wasm3Exported(core, WasmBdr) ? tic_script_bdr : 0)
+        | (wasm3Exported(core, WasmMenu) ? tic_script_menu : 0);
+
     return true;
 }
 
-static void callWasmTick(tic_mem* tic)
+static void callWasmFunc(tic_mem* tic, WasmExport func, const s32* arg)
 {
-    // ForceExitCounter = 0;
-
     tic_core* core = (tic_core*)tic;
 
-    IM3Runtime runtime = core->currentVM;
-
-    if(!runtime) { return; }
+    if(!core->currentVM) { return; }
+    if(!wasm3Exported(core, func)) { return; }
 
-    M3Result res = m3_CallV(TIC_function);
-    if(res)
+    const char* error = wasm3Call(core, func, arg);
+    if(error)
     {
-        core->data->error(core->data->data, res);
+        core->data->error(core->data->data, error);
     }
 }
 
-static void callWasmBoot(tic_mem* tic)
+static void callWasmTick(tic_mem* tic)
 {
-    tic_core* core = (tic_core*)tic;
-
-    IM3Runtime runtime = core->currentVM;
-
-    if(!runtime) { return; }
-    if (BOOT_function == NULL) { return; }
+    // ForceExitCounter = 0;
 
-    M3Result res = m3_CallV(BOOT_function);
-    if(res)
-    {
-        core->data->error(core->data->data, res);
-    }
+    callWasmFunc(tic, WasmTic, NULL);
 }
 
-static void callWasmIntFunc(tic_mem* tic, IM3Function func, s32 value, void* data)
+static void callWasmBoot(tic_mem* tic)
 {
-    tic_core* core = (tic_core*)tic;
-
-    IM3Runtime runtime = core->currentVM;
-
-    if(!runtime) { return; }
-    if (func == NULL) { return; }
-
-    M3Result res = m3_CallV(func, value);
-    if(res)
-    {
-        core->data->error(core->data->data, res);
-    }
+    callWasmFunc(tic, WasmBoot, NULL);
 }
 
 static void callWasmScanline(tic_mem* tic, s32 row, void* data)
 {
-    callWasmIntFunc(tic, SCN_function, row, data);
+    callWasmFunc(tic, WasmScn, &row);
 }
 
 static void callWasmBorder(tic_mem* tic, s32 row, void* data)
 {
-    callWasmIntFunc(tic, BDR_function, row, data);
+    callWasmFunc(tic, WasmBdr, &row);
 }
 
 static void callWasmMenu(tic_mem* tic, s32 index, void* data)
 {
-    callWasmIntFunc(tic, MENU_function, index, data);
+    callWasmFunc(tic, WasmMenu, &index);
 }
 
 static inline bool isalnum_(char c) {return isalnum(c) || c == '_';}
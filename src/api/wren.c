@@ -147,7 +147,12 @@ class TIC {\n\
     foreign static reset()\n\
     foreign static exit()\n\
     foreign static fft(start_freq, end_freq)\n\
+    foreign static fft(start_freq, end_freq, bands)\n\
     foreign static ffts(start_freq, end_freq)\n\
+    foreign static ffts(start_freq, end_freq, bands)\n\
+    foreign static memput(dest, data)\n\
+    foreign static blit(x, y, w, h, data)\n\
+    foreign static blit(x, y, w, h, data, packed)\n\
     foreign static map_width__\n\
     foreign static map_height__\n\
     foreign static spritesize__\n\
@@ -204,6 +209,12 @@ class TIC {\n\
     " BDR_FN "(row){}\n\
     " MENU_FN "(index){}\n\
     " OVR_FN "(){}\n\
+}\n\
+\n\
+class RAM {\n\
+    foreign static [addr]\n\
+    foreign static [addr]=(val)\n\
+    foreign static count\n\
 }\n";
 
 static inline void wrenError(WrenVM* vm, const char* msg)
@@ -1106,6 +1117,85 @@ static void wren_poke(WrenVM* vm)
     core->api.poke(tic, address, value, bits);
 }
 
+// strings are byte buffers in Wren, so the data is passed without a copy
+static void wren_memput(WrenVM* vm)
+{
+    if (!isString(vm, 2))
+    {
+        wrenError(vm, "invalid params, memput(dest, data)\n");
+        return;
+    }
+
+    s32 dest = getWrenNumber(vm, 1);
+
+    s32 size = 0;
+    const char* data = wrenGetSlotBytes(vm, 2, &size);
+
+    tic_core* core = getWrenCore(vm); tic_mem* tic = (tic_mem*)core;
+
+    core->api.memput(tic, dest, data, size);
+}
+
+static void wren_blit(WrenVM* vm)
+{
+    if (!isString(vm, 5))
+    {
+        wrenError(vm, "invalid params, blit(x, y, w, h, data, packed)\n");
+        return;
+    }
+
+    s32 x = getWrenNumber(vm, 1);
+    s32 y = getWrenNumber(vm, 2);
+    s32 w = getWrenNumber(vm, 3);
+    s32 h = getWrenNumber(vm, 4);
+
+    s32 size = 0;
+    const char* data = wrenGetSlotBytes(vm, 5, &size);
+
+    bool packed = wrenGetSlotCount(vm) > 6 && wrenGetSlotType(vm, 6) == WREN_TYPE_BOOL && wrenGetSlotBool(vm, 6);
+
+    tic_core* core = getWrenCore(vm); tic_mem* tic = (tic_mem*)core;
+
+    core->api.blit(tic, x, y, w, h, data, size, packed);
+}
+
+// RAM[addr] reads and writes RAM bytes in place, without the peek/poke dispatch
+static void wren_ram_get(WrenVM* vm)
+{
+    tic_core* core = getWrenCore(vm);
+
+    s32 address = getWrenNumber(vm, 1);
+
+    if (address < 0 || address >= TIC_RAM_SIZE)
+    {
+        wrenError(vm, "ram address out of range");
+        return;
+    }
+
+    wrenSetSlotDouble(vm, 0, ((u8*)core->memory.ram)[address]);
+}
+
+static void wren_ram_set(WrenVM* vm)
+{
+    tic_core* core = getWrenCore(vm);
+
+    s32 address = getWrenNumber(vm, 1);
+    u8 value = getWrenNumber(vm, 2);
+
+    if (address < 0 || address >= TIC_RAM_SIZE)
+    {
+        wrenError(vm, "ram address out of range");
+        return;
+    }
+
+    ((u8*)core->memory.ram)[address] = value;
+}
+
+static void wren_ram_count(WrenVM* vm)
+{
+    wrenSetSlotDouble(vm, 0, TIC_RAM_SIZE);
+}
+
 static void wren_peek1(WrenVM* vm)
 {
     tic_core* core = getWrenCore(vm); tic_mem* tic = (tic_mem*)core;
@@ -1475,15 +1565,19 @@ static void wren_fft(WrenVM* vm)
     {
         double start_freq = getWrenNumber(vm, 1);
         double end_freq = -1;
+        bool bands = false;
 
         if (top > 2)
             end_freq = getWrenNumber(vm, 2);
 
-        wrenSetSlotDouble(vm, 0, core->api.fft(tic, start_freq, end_freq));
+        if (top > 3)
+            bands = wrenGetSlotBool(vm, 3);
+
+        wrenSetSlotDouble(vm, 0, core->api.fft(tic, start_freq, end_freq, bands));
         return;
     }
 
-    wrenError(vm, "invalid params, fft(start_freq, end_freq)\n");
+    wrenError(vm, "invalid params, fft(start_freq, end_freq, bands)\n");
 }
 
 static void wren_ffts(WrenVM* vm)
@@ -1496,15 +1590,19 @@ static void wren_ffts(WrenVM* vm)
     {
         double start_freq = getWrenNumber(vm, 1);
         double end_freq = -1;
+        bool bands = false;
 
         if (top > 2)
             end_freq = getWrenNumber(vm, 2);
 
-        wrenSetSlotDouble(vm, 0, core->api.ffts(tic, start_freq, end_freq));
+        if (top > 3)
+            bands = wrenGetSlotBool(vm, 3);
+
+        wrenSetSlotDouble(vm, 0, core->api.ffts(tic, start_freq, end_freq, bands));
         return;
     }
 
-    wrenError(vm, "invalid params, ffts(start_freq, end_freq)\n");
+    wrenError(vm, "invalid params, ffts(start_freq, end_freq, bands)\n");
 }
 
 static WrenForeignMethodFn foreignTicMethods(const char* signature)
@@ -1619,7 +1717,13 @@ static WrenForeignMethodFn foreignTicMethods(const char* signature)
     if (strcmp(signature, "static TIC.fset(_,_,_)"              ) == 0) return wren_fset;
 
     if (strcmp(signature, "static TIC.fft(_,_)"                 ) == 0) return wren_fft;
+    if (strcmp(signature, "static TIC.fft(_,_,_)"               ) == 0) return wren_fft;
     if (strcmp(signature, "static TIC.ffts(_,_)"                ) == 0) return wren_ffts;
+    if (strcmp(signature, "static TIC.ffts(_,_,_)"              ) == 0) return wren_ffts;
+
+    if (strcmp(signature, "static TIC.memput(_,_)"              ) == 0) return wren_memput;
+    if (strcmp(signature, "static TIC.blit(_,_,_,_,_)"          ) == 0) return wren_blit;
+    if (strcmp(signature, "static TIC.blit(_,_,_,_,_,_)"        ) == 0) return wren_blit;
 
     // internal functions
     if (strcmp(signature, "static TIC.map_width__"              ) == 0) return wren_map_width;
@@ -1630,6 +1734,10 @@ static WrenForeignMethodFn foreignTicMethods(const char* signature)
     if (strcmp(signature, "static TIC.spr__(_,_,_,_,_,_,_)"     ) == 0) return wren_spr_internal;
     if (strcmp(signature, "static TIC.mgeti__(_)"               ) == 0) return wren_mgeti;
 
+    if (strcmp(signature, "static RAM.[_]"                      ) == 0) return wren_ram_get;
+    if (strcmp(signature, "static RAM.[_]=(_)"                  ) == 0) return wren_ram_set;
+    if (strcmp(signature, "static RAM.count"                    ) == 0) return wren_ram_count;
+
     return NULL;
 }
 
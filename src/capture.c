@@ -0,0 +1,475 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "capture.h"
+#include "tools.h"
+#include "tic_assert.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char CaptureMagic[] = "TICV";
+enum {CaptureVersion = 1, HeaderSize = STRLEN(CaptureMagic) + 1 + sizeof(u32)};
+
+enum
+{
+    BlockSize = 64,
+    Blocks = sizeof(tic_screen) / BlockSize,
+    BlockMaskSize = (Blocks + BITS_IN_BYTE - 1) / BITS_IN_BYTE,
+    EndOfRows = 0xff,
+};
+
+enum
+{
+    FrameScreen0    = 1 << 0,
+    FrameScreen1    = 1 << 1,
+    FrameAudio      = 1 << 2,
+};
+
+static_assert(sizeof(tic_screen) % BlockSize == 0, "tic_capture_block_size");
+static_assert(TIC80_FULLHEIGHT < EndOfRows, "tic_capture_rows");
+
+struct tic_capture
+{
+    tic_capture_writer write;
+    tic_capture_reader read;
+    void* data;
+
+    s32 samplerate;
+    s32 frames;
+    bool error;
+
+    // last written or read state, frames are stored as deltas from it
+    tic_capture_frame frame;
+    tic_capture_row last;
+
+    // rows collected during the current blit
+    tic_capture_row rows[TIC80_FULLHEIGHT];
+
+    u8* buffer;
+    s32 size;
+    s32 capacity;
+    s32 pos;
+
+    s32 samplesCapacity;
+
+    // the frame written by the last blit waits for its audio, offset of its flags byte
+    s32 pending;
+};
+
+static void reserve(tic_capture* capture, s32 size)
+{
+    if(capture->size + size > capture->capacity)
+    {
+        capture->capacity = MAX(capture->capacity * 2, capture->size + size);
+        capture->buffer = realloc(capture->buffer, capture->capacity);
+    }
+}
+
+static inline void putByte(tic_capture* capture, u8 value)
+{
+    capture->buffer[capture->size++] = value;
+}
+
+static inline void putBytes(tic_capture* capture, const void* data, s32 size)
+{
+    memcpy(capture->buffer + capture->size, data, size);
+    capture->size += size;
+}
+
+static void putU32(tic_capture* capture, u32 value)
+{
+    for(s32 i = 0; i < sizeof value; i++)
+        putByte(capture, value >> (i * BITS_IN_BYTE));
+}
+
+static inline void putVarint(tic_capture* capture, u32 value)
+{
+    do
+    {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        putByte(capture, value ? byte | 0x80 : byte);
+    }
+    while(value);
+}
+
+static inline u32 zigzag(s32 value)
+{
+    return ((u32)value << 1) ^ (u32)(value >> 31);
+}
+
+static inline s32 unzigzag(u32 value)
+{
+    return (s32)(value >> 1) ^ -(s32)(value & 1);
+}
+
+static void flush(tic_capture* capture)
+{
+    if(capture->size && !capture->error)
+        capture->error = !capture->write(capture->buffer, capture->size, capture->data);
+
+    capture->size = 0;
+}
+
+// reading is done in chunks, the buffer keeps the unread tail
+static bool fill(tic_capture* capture, s32 size)
+{
+    if(capture->size - capture->pos >= size)
+        return true;
+
+    memmove(capture->buffer, capture->buffer + capture->pos, capture->size - capture->pos);
+    capture->size -= capture->pos;
+    capture->pos = 0;
+
+    while(capture->size < size)
+    {
+        reserve(capture, MAX(size, 64 * 1024));
+
+        s32 read = capture->read(capture->buffer + capture->size, capture->capacity - capture->size, capture->data);
+        if(read <= 0)
+            return false;
+
+        capture->size += read;
+    }
+
+    return true;
+}
+
+static bool getBytes(tic_capture* capture, void* data, s32 size)
+{
+    if(!fill(capture, size))
+        return false;
+
+    memcpy(data, capture->buffer + capture->pos, size);
+    capture->pos += size;
+    return true;
+}
+
+static bool getByte(tic_capture* capture, u8* value)
+{
+    return getBytes(capture, value, 1);
+}
+
+static bool getVarint(tic_capture* capture, u32* value)
+{
+    *value = 0;
+
+    for(s32 shift = 0; shift < sizeof *value * BITS_IN_BYTE; shift += 7)
+    {
+        u8 byte;
+        if(!getByte(capture, &byte))
+            return false;
+
+        *value |= (u32)(byte & 0x7f) << shift;
+
+        if(!(byte & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+static void reserveSamples(tic_capture* capture, s32 count)
+{
+    if(count > capture->samplesCapacity)
+    {
+        capture->samplesCapacity = count;
+        capture->frame.samples = realloc(capture->frame.samples, count * sizeof(s16));
+    }
+}
+
+tic_capture* tic_capture_create(s32 samplerate, tic_capture_writer write, void* data)
+{
+    tic_capture* capture = calloc(1, sizeof(tic_capture));
+    capture->write = write;
+    capture->data = data;
+    capture->samplerate = samplerate;
+    capture->pending = -1;
+
+    reserve(capture, HeaderSize);
+    putBytes(capture, CaptureMagic, STRLEN(CaptureMagic));
+    putByte(capture, CaptureVersion);
+    putU32(capture, samplerate);
+    flush(capture);
+
+    return capture;
+}
+
+tic_capture* tic_capture_open(tic_capture_reader read, void* data)
+{
+    tic_capture* capture = calloc(1, sizeof(tic_capture));
+    capture->read = read;
+    capture->data = data;
+
+    u8 header[HeaderSize];
+    if(getBytes(capture, header, HeaderSize)
+        && memcmp(header, CaptureMagic, STRLEN(CaptureMagic)) == 0
+        && header[STRLEN(CaptureMagic)] == CaptureVersion)
+    {
+        const u8* rate = header + STRLEN(CaptureMagic) + 1;
+        capture->samplerate = rate[0] | rate[1] << 8 | rate[2] << 16 | (u32)rate[3] << 24;
+        return capture;
+    }
+
+    tic_capture_close(capture);
+    return NULL;
+}
+
+static void endFrame(tic_capture* capture)
+{
+    capture->pending = -1;
+    capture->frames++;
+    flush(capture);
+}
+
+bool tic_capture_close(tic_capture* capture)
+{
+    if(capture->write && capture->pending >= 0)
+        endFrame(capture);
+
+    bool done = !capture->error;
+
+    free(capture->frame.samples);
+    free(capture->buffer);
+    free(capture);
+
+    return done;
+}
+
+void tic_capture_scanline(tic_capture* capture, s32 row, const tic_vram* bank0, const tic_vram* bank1)
+{
+    tic_capture_row* state = &capture->rows[row];
+
+    state->palette[0] = bank0->palette;
+    state->palette[1] = bank1->palette;
+    state->border = bank0->vars.border;
+    state->clear = bank1->vars.clear;
+    state->offset[0].x = bank0->vars.offset.x;
+    state->offset[0].y = bank0->vars.offset.y;
+    state->offset[1].x = bank1->vars.offset.x;
+    state->offset[1].y = bank1->vars.offset.y;
+}
+
+void tic_capture_write(tic_capture* capture, const tic_vram* bank0, const tic_vram* bank1)
+{
+    // the previous blit got no sound synthesized after it
+    if(capture->pending >= 0)
+        endFrame(capture);
+
+    const tic_screen* screens[] = {&bank0->screen, &bank1->screen};
+    tic_capture_frame* frame = &capture->frame;
+
+    u8 masks[TIC_CAPTURE_VBANKS][BlockMaskSize] = {0};
+    s32 changed[TIC_CAPTURE_VBANKS] = {0};
+
+    for(s32 i = 0; i < TIC_CAPTURE_VBANKS; i++)
+        for(s32 b = 0; b < Blocks; b++)
+            if(memcmp(screens[i]->data + b * BlockSize, frame->screen[i].data + b * BlockSize, BlockSize))
+                masks[i][b / BITS_IN_BYTE] |= 1 << (b % BITS_IN_BYTE), changed[i]++;
+
+    u8 flags = (changed[0] ? FrameScreen0 : 0) | (changed[1] ? FrameScreen1 : 0);
+
+    reserve(capture, 1
+        + TIC80_FULLHEIGHT * (1 + sizeof(tic_capture_row)) + 1
+        + TIC_CAPTURE_VBANKS * (BlockMaskSize + sizeof(tic_screen)));
+
+    capture->pending = capture->size;
+    putByte(capture, flags);
+
+    for(s32 row = 0; row < TIC80_FULLHEIGHT; row++)
+    {
+        const tic_capture_row* state = &capture->rows[row];
+
+        if(memcmp(state, &capture->last, sizeof *state))
+        {
+            putByte(capture, row);
+            putBytes(capture, state, sizeof *state);
+            capture->last = *state;
+        }
+    }
+
+    putByte(capture, EndOfRows);
+
+    for(s32 i = 0; i < TIC_CAPTURE_VBANKS; i++)
+    {
+        if(changed[i])
+        {
+            putBytes(capture, masks[i], BlockMaskSize);
+
+            for(s32 b = 0; b < Blocks; b++)
+                if(masks[i][b / BITS_IN_BYTE] & (1 << (b % BITS_IN_BYTE)))
+                    putBytes(capture, screens[i]->data + b * BlockSize, BlockSize);
+
+            frame->screen[i] = *screens[i];
+        }
+    }
+}
+
+void tic_capture_audio(tic_capture* capture, const s16* samples, s32 count)
+{
+    if(capture->pending < 0)
+        return;
+
+    if(count)
+    {
+        reserve(capture, 5 + count * 3);
+        capture->buffer[capture->pending] |= FrameAudio;
+        putVarint(capture, count);
+
+        s16 prev[TIC80_SAMPLE_CHANNELS] = {0};
+        for(s32 i = 0; i < count; i++)
+        {
+            s16* last = &prev[i % TIC80_SAMPLE_CHANNELS];
+            putVarint(capture, zigzag(samples[i] - *last));
+            *last = samples[i];
+        }
+    }
+
+    endFrame(capture);
+}
+
+const tic_capture_frame* tic_capture_read(tic_capture* capture)
+{
+    tic_capture_frame* frame = &capture->frame;
+
+    u8 flags;
+    if(!getByte(capture, &flags))
+        return NULL;
+
+    u8 next;
+    if(!getByte(capture, &next))
+        return NULL;
+
+    for(s32 row = 0; row < TIC80_FULLHEIGHT; row++)
+    {
+        if(next == row)
+        {
+            if(!getBytes(capture, &capture->last, sizeof capture->last) || !getByte(capture, &next))
+                return NULL;
+        }
+
+        frame->rows[row] = capture->last;
+    }
+
+    if(next != EndOfRows)
+        return NULL;
+
+    for(s32 i = 0; i < TIC_CAPTURE_VBANKS; i++)
+    {
+        if(flags & (FrameScreen0 << i))
+        {
+            u8 mask[BlockMaskSize];
+            if(!getBytes(capture, mask, BlockMaskSize))
+                return NULL;
+
+            for(s32 b = 0; b < Blocks; b++)
+                if(mask[b / BITS_IN_BYTE] & (1 << (b % BITS_IN_BYTE)))
+                    if(!getBytes(capture, frame->screen[i].data + b * BlockSize, BlockSize))
+                        return NULL;
+        }
+    }
+
+    frame->count = 0;
+
+    if(flags & FrameAudio)
+    {
+        u32 count;
+        if(!getVarint(capture, &count))
+            return NULL;
+
+        reserveSamples(capture, count);
+
+        s16 prev[TIC80_SAMPLE_CHANNELS] = {0};
+        for(s32 i = 0; i < count; i++)
+        {
+            u32 delta;
+            if(!getVarint(capture, &delta))
+                return NULL;
+
+            s16* last = &prev[i % TIC80_SAMPLE_CHANNELS];
+            frame->samples[i] = *last += unzigzag(delta);
+        }
+
+        frame->count = count;
+    }
+
+    capture->frames++;
+    return frame;
+}
+
+s32 tic_capture_samplerate(const tic_capture* capture)
+{
+    return capture->samplerate;
+}
+
+s32 tic_capture_frames(const tic_capture* capture)
+{
+    return capture->frames;
+}
+
+static inline u32 rgba(const tic_palette* palette, u8 index)
+{
+    const tic_rgb* c = &palette->colors[index];
+    u32 value;
+    u8* ptr = (u8*)&value;
+    ptr[0] = c->r, ptr[1] = c->g, ptr[2] = c->b, ptr[3] = 0xff;
+    return value;
+}
+
+// mirrors tic_core_blit_ex(), the output is RGBA
+void tic_capture_render(const tic_capture_frame* frame, u32* pixels)
+{
+    enum{OffsetY = TIC80_HEIGHT - TIC80_MARGIN_TOP};
+
+    for(s32 row = 0; row < TIC80_FULLHEIGHT; row++)
+    {
+        const tic_capture_row* state = &frame->rows[row];
+        u32* ptr = pixels + row * TIC80_FULLWIDTH;
+        u32 border = rgba(&state->palette[0], state->border);
+
+        for(s32 x = 0; x < TIC80_FULLWIDTH; x++)
+            ptr[x] = border;
+
+        if(row < TIC80_MARGIN_TOP || row >= TIC80_FULLHEIGHT - TIC80_MARGIN_BOTTOM)
+            continue;
+
+        u32 pal[TIC_CAPTURE_VBANKS][TIC_PALETTE_SIZE];
+        for(s32 i = 0; i < TIC_CAPTURE_VBANKS; i++)
+            for(s32 c = 0; c < TIC_PALETTE_SIZE; c++)
+                pal[i][c] = rgba(&state->palette[i], c);
+
+        s32 start0 = (row + state->offset[0].y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
+        s32 start1 = (row + state->offset[1].y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
+
+        ptr += TIC80_MARGIN_LEFT;
+
+        for(s32 x = TIC80_WIDTH; x != 2 * TIC80_WIDTH; ++x)
+        {
+            u8 pix = tic_tool_peek4(frame->screen[1].data, (x + state->offset[1].x) % TIC80_WIDTH + start1);
+
+            *ptr++ = pix != state->clear
+                ? pal[1][pix]
+                : pal[0][tic_tool_peek4(frame->screen[0].data, (x + state->offset[0].x) % TIC80_WIDTH + start0)];
+        }
+    }
+}
@@ -0,0 +1,79 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "tic.h"
+
+// native video capture format:
+// header: "TICV" magic, version byte, samplerate u32
+// frame:  flags byte, then
+//         - scanline states that differ from the previous scanline:
+//           row byte + palettes, border, clear and offsets, 0xff terminates the list
+//         - for every changed vbank screen: bitmask of changed 64-byte blocks + the blocks
+//         - audio: varint sample count + zigzag varint deltas per channel
+// a frame is opened by tic_capture_write() at the end of the blit and closed by
+// tic_capture_audio() once the sound of the same tick is synthesized
+// the screens are stored as they are at the end of the blit, so pixel changes
+// made from SCN() are not reproduced, palette and offset changes are
+
+#define TIC_CAPTURE_VBANKS 2
+
+typedef struct
+{
+    tic_palette palette[TIC_CAPTURE_VBANKS];
+    u8 border;
+    u8 clear;
+
+    struct
+    {
+        s8 x;
+        s8 y;
+    } offset[TIC_CAPTURE_VBANKS];
+} tic_capture_row;
+
+typedef struct
+{
+    tic_capture_row rows[TIC80_FULLHEIGHT];
+    tic_screen screen[TIC_CAPTURE_VBANKS];
+
+    s16* samples;
+    s32 count;
+} tic_capture_frame;
+
+typedef bool(*tic_capture_writer)(const void* buffer, s32 size, void* data);
+typedef s32(*tic_capture_reader)(void* buffer, s32 size, void* data);
+
+typedef struct tic_capture tic_capture;
+
+tic_capture*    tic_capture_create(s32 samplerate, tic_capture_writer write, void* data);
+tic_capture*    tic_capture_open(tic_capture_reader read, void* data);
+bool            tic_capture_close(tic_capture* capture);
+
+void            tic_capture_scanline(tic_capture* capture, s32 row, const tic_vram* bank0, const tic_vram* bank1);
+void            tic_capture_write(tic_capture* capture, const tic_vram* bank0, const tic_vram* bank1);
+void            tic_capture_audio(tic_capture* capture, const s16* samples, s32 count);
+const tic_capture_frame* tic_capture_read(tic_capture* capture);
+
+s32             tic_capture_samplerate(const tic_capture* capture);
+s32             tic_capture_frames(const tic_capture* capture);
+void            tic_capture_render(const tic_capture_frame* frame, u32* pixels);
@@ -150,6 +150,21 @@ void tic_api_memset(tic_mem* memory, s32 dst, u8 val, s32 size)
     }
 }
 
+void tic_api_memput(tic_mem* memory, s32 dst, const void* src, s32 size)
+{
+    s32 bound = sizeof(tic_ram) - size;
+
+    if (src
+        && size >= 0
+        && size <= sizeof(tic_ram)
+        && dst >= 0
+        && dst <= bound)
+    {
+        u8* base = (u8*)memory->ram;
+        memmove(base + dst, src, size);
+    }
+}
+
 void tic_api_trace(tic_mem* memory, const char* text, u8 color)
 {
     tic_core* core = (tic_core*)memory;
@@ -233,6 +248,9 @@ void tic_api_sync(tic_mem* tic, u32 mask, s32 bank, bool toCart)
     }
 
     core->state.synced |= mask;
+
+    if(toCart && mask && core->data && core->data->sync)
+        core->data->sync(core->data->data, mask, bank);
 }
 
 double tic_api_time(tic_mem* memory)
@@ -244,7 +262,7 @@ double tic_api_time(tic_mem* memory)
 s32 tic_api_tstamp(tic_mem* memory)
 {
     tic_core* core = (tic_core*)memory;
-    return (s32)time(NULL);
+    return core->data->tstamp ? core->data->tstamp(core->data->data) : (s32)time(NULL);
 }
 
 static void updateSaveid(tic_mem* memory)
@@ -402,6 +420,7 @@ static bool tic_init_vm(tic_core* core, const char* code, const tic_script* conf
     tic_close_current_vm(core);
     // set current script config and init
     core->currentScript = config;
+    core->callbacks = tic_script_all;
 
     bool done = config->init((tic_mem*)core, code);
     if(!done)
@@ -433,6 +452,26 @@ s32 tic_api_vbank(tic_mem* tic, s32 bank)
     return prev;
 }
 
+static bool findName(const char* data, s32 size, const char* name)
+{
+    s32 len = (s32)strlen(name);
+
+    for(s32 i = 0; i + len <= size; i++)
+        if(data[i] == *name && memcmp(data + i, name, len) == 0)
+            return true;
+
+    return false;
+}
+
+// conservative check used to skip the raster callbacks when the cart can't have them,
+// a false positive only means the serial blit with callbacks
+static bool hasRasterCallbacks(const char* code, s32 size)
+{
+    return findName(code, size, SCN_FN)
+        || findName(code, size, BDR_FN)
+        || findName(code, size, "scanline");
+}
+
 void tic_core_tick(tic_mem* tic, tic_tick_data* data)
 {
     tic_core* core = (tic_core*)tic;
@@ -482,6 +521,9 @@ void tic_core_tick(tic_mem* tic, tic_tick_data* data)
             config->boot(tic);
             core->state.tick = config->tick;
             core->state.callback = config->callback;
+            core->state.raster = config->useBinarySection
+                ? hasRasterCallbacks(tic->cart.binary.data, tic->cart.binary.size)
+                : hasRasterCallbacks(code, strlen(code));
             core->state.initialized = true;
         }
         else return;
@@ -533,12 +575,22 @@ void tic_core_close(tic_mem* memory)
     blip_delete(core->blip.left);
     blip_delete(core->blip.right);
 
+    if(core->blit.pool)
+        tic_pool_free(core->blit.pool);
+
+    if(core->replay.record)
+        tic_replay_close(core->replay.record);
+
+    if(core->replay.play)
+        tic_replay_close(core->replay.play);
+
 #ifdef _3DS
     linearFree(memory->product.screen);
 #else
     free(memory->product.screen);
 #endif
     free(memory->product.samples.buffer);
+    free(memory->base_ram);
     free(core);
 }
 
@@ -629,6 +681,9 @@ static inline void updbdr(tic_mem* tic, s32 row, u32* ptr, tic_blit_callback clb
         updpal(tic, pal0, pal1);
 
     memset4(ptr, pal0->data[vbank0(core)->vars.border], TIC80_FULLWIDTH);
+
+    if(core->capture)
+        tic_capture_scanline(core->capture, row, vbank0(core), vbank1(core));
 }
 
 static inline u32 blitpix(tic_mem* tic, s32 offset0, s32 offset1, const tic_blitpal* pal0, const tic_blitpal* pal1)
@@ -641,53 +696,77 @@ static inline u32 blitpix(tic_mem* tic, s32 offset0, s32 offset1, const tic_blit
         : pal0->data[tic_tool_peek4(vbank0(core)->screen.data, offset0)];
 }
 
-void tic_core_blit_ex(tic_mem* tic, tic_blit_callback clb)
+static inline void blitrow(tic_mem* tic, s32 row, tic_blit_callback clb, tic_blitpal* pal0, tic_blitpal* pal1)
 {
     tic_core* core = (tic_core*)tic;
+    u32* rowPtr = tic->product.screen + row * TIC80_FULLWIDTH;
 
-    tic_blitpal pal0, pal1;
-    updpal(tic, &pal0, &pal1);
-
-    s32 row = 0;
-    u32* rowPtr = tic->product.screen;
+    updbdr(tic, row, rowPtr, clb, pal0, pal1);
 
-#define UPDBDR() updbdr(tic, row, rowPtr, clb, &pal0, &pal1)
+    if(row < TIC80_MARGIN_TOP || row >= TIC80_FULLHEIGHT - TIC80_MARGIN_BOTTOM)
+        return;
 
-    for(; row != TIC80_MARGIN_TOP; ++row, rowPtr += TIC80_FULLWIDTH)
-        UPDBDR();
+    rowPtr += TIC80_MARGIN_LEFT;
 
-    for(; row != TIC80_FULLHEIGHT - TIC80_MARGIN_BOTTOM; ++row)
+    if(*(u16*)&vbank0(core)->vars.offset == 0 && *(u16*)&vbank1(core)->vars.offset == 0)
+    {
+        // render line without XY offsets
+        for(s32 x = (row - TIC80_MARGIN_TOP) * TIC80_WIDTH, end = x + TIC80_WIDTH; x != end; ++x)
+            *rowPtr++ = blitpix(tic, x, x, pal0, pal1);
+    }
+    else
     {
-        UPDBDR();
-        rowPtr += TIC80_MARGIN_LEFT;
+        // render line with XY offsets
+        enum{OffsetY = TIC80_HEIGHT - TIC80_MARGIN_TOP};
+        s32 start0 = (row + vbank0(core)->vars.offset.y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
+        s32 start1 = (row + vbank1(core)->vars.offset.y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
+        s32 offsetX0 = vbank0(core)->vars.offset.x;
+        s32 offsetX1 = vbank1(core)->vars.offset.x;
+
+        for(s32 x = TIC80_WIDTH; x != 2 * TIC80_WIDTH; ++x)
+            *rowPtr++ = blitpix(tic, (x + offsetX0) % TIC80_WIDTH + start0,
+                (x + offsetX1) % TIC80_WIDTH + start1, pal0, pal1);
+    }
+}
 
-        if(*(u16*)&vbank0(core)->vars.offset == 0 && *(u16*)&vbank1(core)->vars.offset == 0)
-        {
-            // render line without XY offsets
-            for(s32 x = (row - TIC80_MARGIN_TOP) * TIC80_WIDTH, end = x + TIC80_WIDTH; x != end; ++x)
-                *rowPtr++ = blitpix(tic, x, x, &pal0, &pal1);
-        }
-        else
-        {
-            // render line with XY offsets
-            enum{OffsetY = TIC80_HEIGHT - TIC80_MARGIN_TOP};
-            s32 start0 = (row + vbank0(core)->vars.offset.y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
-            s32 start1 = (row + vbank1(core)->vars.offset.y + OffsetY) % TIC80_HEIGHT * TIC80_WIDTH;
-            s32 offsetX0 = vbank0(core)->vars.offset.x;
-            s32 offsetX1 = vbank1(core)->vars.offset.x;
-
-            for(s32 x = TIC80_WIDTH; x != 2 * TIC80_WIDTH; ++x)
-                *rowPtr++ = blitpix(tic, (x + offsetX0) % TIC80_WIDTH + start0,
-                    (x + offsetX1) % TIC80_WIDTH + start1, &pal0, &pal1);
-        }
+typedef struct
+{
+    tic_mem* tic;
+    tic_blitpal pal0;
+    tic_blitpal pal1;
+    s32 jobs;
+} BlitJob;
 
-        rowPtr += TIC80_MARGIN_RIGHT;
-    }
+static void blitjob(s32 index, void* data)
+{
+    BlitJob* job = data;
+    tic_blitpal pal0 = job->pal0, pal1 = job->pal1;
+
+    for(s32 row = index * TIC80_FULLHEIGHT / job->jobs, end = (index + 1) * TIC80_FULLHEIGHT / job->jobs; row != end; ++row)
+        blitrow(job->tic, row, (tic_blit_callback){0}, &pal0, &pal1);
+}
+
+void tic_core_blit_ex(tic_mem* tic, tic_blit_callback clb)
+{
+    tic_core* core = (tic_core*)tic;
+
+    tic_blitpal pal0, pal1;
+    updpal(tic, &pal0, &pal1);
 
-    for(; row != TIC80_FULLHEIGHT; ++row, rowPtr += TIC80_FULLWIDTH)
-        UPDBDR();
+    // without raster callbacks the rows are independent and can be split between the workers
+    if(core->blit.pool && !clb.scanline && !clb.border)
+    {
+        BlitJob job = {tic, pal0, pal1, tic_pool_threads(core->blit.pool) + 1};
+        tic_pool_run(core->blit.pool, job.jobs, blitjob, &job);
+    }
+    else
+    {
+        for(s32 row = 0; row != TIC80_FULLHEIGHT; ++row)
+            blitrow(tic, row, clb, &pal0, &pal1);
+    }
 
-#undef  UPDBDR
+    if(core->capture)
+        tic_capture_write(core->capture, vbank0(core), vbank1(core));
 }
 
 static inline void scanline(tic_mem* memory, s32 row, void* data)
@@ -706,9 +785,53 @@ static inline void border(tic_mem* memory, s32 row, void* data)
         core->state.callback.border(memory, row, data);
 }
 
+u32 tic_script_callbacks(tic_mem* memory)
+{
+    return ((tic_core*)memory)->callbacks;
+}
+
 void tic_core_blit(tic_mem* tic)
 {
-    tic_core_blit_ex(tic, (tic_blit_callback){scanline, border, NULL});
+    tic_core* core = (tic_core*)tic;
+
+    // carts without SCN/BDR skip the callbacks, which also enables the parallel blit;
+    // the flags are read on every blit, a runtime updates them after each TIC
+    u32 callbacks = core->state.initialized
+        && (core->callbacks & tic_script_probed || core->state.raster) ? core->callbacks : 0;
+
+    tic_core_blit_ex(tic, (tic_blit_callback)
+    {
+        .scanline = callbacks & tic_script_scn ? scanline : NULL,
+        .border = callbacks & tic_script_bdr ? border : NULL,
+    });
+}
+
+void tic_core_blit_threads(tic_mem* tic, s32 threads)
+{
+    tic_core* core = (tic_core*)tic;
+
+    if(core->blit.pool)
+    {
+        tic_pool_free(core->blit.pool);
+        core->blit.pool = NULL;
+    }
+
+    if(threads > 0)
+    {
+        core->blit.pool = tic_pool_create(threads);
+
+        if(tic_pool_threads(core->blit.pool) == 0)
+        {
+            tic_pool_free(core->blit.pool);
+            core->blit.pool = NULL;
+        }
+    }
+}
+
+void tic_core_capture(tic_mem* tic, tic_capture* capture)
+{
+    tic_core* core = (tic_core*)tic;
+    core->capture = capture;
 }
 
 tic_mem* tic_core_create(s32 samplerate, tic80_pixel_color_format format)
@@ -25,6 +25,9 @@
 #include "api.h"
 #include "tools.h"
 #include "script.h"
+#include "replay.h"
+#include "capture.h"
+#include "ext/thread.h"
 
 #define CLOCKRATE (255<<13)
 #define TIC_DEFAULT_COLOR 15
@@ -166,6 +169,7 @@ typedef struct
     } clip;
 
     bool initialized;
+    bool raster; // the source mentions SCN/BDR, used when the runtime can't probe them
 } tic_core_state_data;
 
 typedef struct
@@ -174,7 +178,10 @@ typedef struct
     tic80_pixel_color_format screen_format;
 
     void* currentVM;
+    // handles of the script callbacks, owned by the runtime of currentVM
+    void* scriptCallbacks;
     const tic_script* currentScript;
+    u32 callbacks;
 
     struct
     {
@@ -186,6 +193,24 @@ typedef struct
     tic_tick_data* data;
     tic_core_state_data state;
 
+    struct
+    {
+        tic_replay* record;
+        tic_replay* play;
+        tic_replay_frame frame;
+
+        // counter origin after the replay ends, so the clock continues
+        // from the last replayed value instead of jumping to the real one
+        u64 start;
+    } replay;
+
+    tic_capture* capture;
+
+    struct
+    {
+        tic_pool* pool;
+    } blit;
+
     struct
     {
         tic_core_state_data state;
@@ -470,6 +470,65 @@ u8 tic_api_pix(tic_mem* memory, s32 x, s32 y, u8 color, bool get)
     return 0;
 }
 
+void tic_api_blit(tic_mem* memory, s32 x, s32 y, s32 width, s32 height, const void* data, s32 size, bool packed)
+{
+    tic_core* core = (tic_core*)memory;
+
+    if (!data || width <= 0 || height <= 0) return;
+
+    // only the rows fully present in data are drawn
+    s32 stride = packed ? (width + 1) / 2 : width;
+    height = MIN(height, size / stride);
+
+    s32 l = MAX(x, core->state.clip.l);
+    s32 t = MAX(y, core->state.clip.t);
+    s32 r = MIN(x + width, core->state.clip.r);
+    s32 b = MIN(y + height, core->state.clip.b);
+
+    if (l >= r || t >= b) return;
+
+    u8 mapping[TIC_PALETTE_SIZE];
+    bool identity = true;
+
+    for (s32 i = 0; i < TIC_PALETTE_SIZE; i++)
+        identity &= (mapping[i] = mapColor(memory, i)) == i;
+
+    u8* screen = memory->ram->vram.screen.data;
+    const u8* src = data;
+
+    for (s32 j = t; j < b; j++)
+    {
+        const u8* row = src + (j - y) * stride;
+        s32 start = j * TIC80_WIDTH;
+        s32 i = l;
+
+        if (packed)
+        {
+            // with an even x source and screen nibbles line up, so whole bytes are copied
+            if (identity && (x & 1) == 0)
+            {
+                if (i & 1)
+                {
+                    tic_tool_poke4(screen, start + i, tic_tool_peek4(row, i - x));
+                    i++;
+                }
+
+                s32 bytes = (r - i) / 2;
+                memcpy(screen + (start + i) / 2, row + (i - x) / 2, bytes);
+                i += bytes * 2;
+            }
+
+            for (; i < r; i++)
+                tic_tool_poke4(screen, start + i, mapping[tic_tool_peek4(row, i - x)]);
+        }
+        else
+        {
+            for (; i < r; i++)
+                tic_tool_poke4(screen, start + i, mapping[row[i - x] & 0xf]);
+        }
+    }
+}
+
 void tic_api_rectb(tic_mem* memory, s32 x, s32 y, s32 width, s32 height, u8 color)
 {
     tic_core* core = (tic_core*)memory;
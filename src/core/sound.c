@@ -83,8 +83,32 @@ static inline s32 param2val(const tic_track_row* row)
 static void update_amp(blip_buffer_t* blip, tic_sound_register_data* data, s32 new_amp)
 {
     s32 delta = new_amp - data->amp;
-    data->amp += delta;
-    blip_add_delta(blip, data->time, delta);
+
+    // zero delta doesn't change the blip buffer
+    if (delta)
+    {
+        data->amp += delta;
+        blip_add_delta(blip, data->time, delta);
+    }
+}
+
+// number of steps the synth loops make until the end of the frame
+static inline s32 stepsLeft(s32 time, s32 period)
+{
+    return time < ENDTIME ? (ENDTIME - time + period - 1) / period : 0;
+}
+
+// the channel is silent, only drop the amplitude and advance the time
+static inline s32 skipSilence(blip_buffer_t* blip, tic_sound_register_data* data, s32 period)
+{
+    s32 steps = stepsLeft(data->time, period);
+
+    if (steps)
+        update_amp(blip, data, 0);
+
+    data->time += steps * period;
+
+    return steps;
 }
 
 static inline s32 freq2period(s32 freq)
@@ -106,10 +130,26 @@ static inline s32 getAmp(s32 volume, s32 amp)
     return amp * volume / MAX_VOLUME / (TIC_SOUND_CHANNELS + 1);
 }
 
+static bool isSilentPcm(const tic_pcm* pcm)
+{
+    for (s32 i = 0; i < TIC_PCM_SIZE; i++)
+        if (pcm->data[i])
+            return false;
+
+    return true;
+}
+
 static void runPcm(blip_buffer_t* blip, const tic_pcm* pcm, tic_sound_register_data* data)
 {
     enum{Period = ENDTIME / TIC_PCM_SIZE};
 
+    if (isSilentPcm(pcm))
+    {
+        data->time = 0;
+        data->phase = (data->phase + skipSilence(blip, data, Period)) % TIC_PCM_SIZE;
+        return;
+    }
+
     for (data->time = 0; data->time < ENDTIME; data->time += Period, data->phase = (data->phase + 1) % TIC_PCM_SIZE)
     {
         update_amp(blip, data, getAmp(MAX_VOLUME, pcm->data[data->phase] * SHRT_MAX / UCHAR_MAX));
@@ -120,9 +160,22 @@ static void runEnvelope(blip_buffer_t* blip, const tic_sound_register* reg, tic_
 {
     s32 period = freq2period(tic_sound_register_get_freq(reg) * ENVELOPE_FREQ_SCALE);
 
+    // phase could be left by the noise LFSR
+    data->phase %= WAVE_VALUES;
+
+    if (reg->volume == 0 || stereo_volume == 0)
+    {
+        data->phase = (data->phase + skipSilence(blip, data, period)) % WAVE_VALUES;
+        return;
+    }
+
+    s32 amps[1 << WAVE_VALUE_BITS];
+    for (s32 i = 0; i < COUNT_OF(amps); i++)
+        amps[i] = getAmp(reg->volume, i * SHRT_MAX / MAX_VOLUME * stereo_volume / MAX_VOLUME);
+
     for (; data->time < ENDTIME; data->time += period, data->phase = (data->phase + 1) % WAVE_VALUES)
     {
-        update_amp(blip, data, getAmp(reg->volume, tic_tool_peek4(reg->waveform.data, data->phase) * SHRT_MAX / MAX_VOLUME * stereo_volume / MAX_VOLUME));
+        update_amp(blip, data, amps[tic_tool_peek4(reg->waveform.data, data->phase)]);
     }
 }
 
@@ -135,9 +188,20 @@ static void runNoise(blip_buffer_t* blip, const tic_sound_register* reg, tic_sou
     s32 period = freq2period(tic_sound_register_get_freq(reg));
     s32 fb = *reg->waveform.data ? 0x14 : 0x12000;
 
+    if (reg->volume == 0 || stereo_volume == 0)
+    {
+        // the LFSR still has to be stepped to stay in sync
+        for (s32 steps = skipSilence(blip, data, period); steps; steps--)
+            data->phase = ((data->phase & 1) * fb) ^ (data->phase >> 1);
+
+        return;
+    }
+
+    s32 amp = getAmp(reg->volume, stereo_volume * SHRT_MAX / MAX_VOLUME);
+
     for (; data->time < ENDTIME; data->time += period, data->phase = ((data->phase & 1) * fb) ^ (data->phase >> 1))
     {
-        update_amp(blip, data, getAmp(reg->volume, (data->phase & 1) ? stereo_volume * SHRT_MAX / MAX_VOLUME : 0));
+        update_amp(blip, data, (data->phase & 1) ? amp : 0);
     }
 }
 
@@ -551,6 +615,9 @@ void tic_core_synth_sound(tic_mem* memory)
     blip_read_samples(core->blip.left, product->samples.buffer, core->samplerate / TIC80_FRAMERATE, TIC80_SAMPLE_CHANNELS);
     blip_read_samples(core->blip.right, product->samples.buffer + 1, core->samplerate / TIC80_FRAMERATE, TIC80_SAMPLE_CHANNELS);
 
+    if (core->capture)
+        tic_capture_audio(core->capture, product->samples.buffer, product->samples.count);
+
     // if the head has advanced, we can advance the tail too. Otherwise, we just
     // keep synthesizing audio using the last known register values, so at least we don't get crackles
     if (core->state.sound_ringbuf_tail != core->state.sound_ringbuf_head) {
@@ -21,6 +21,26 @@ ma_context context;
 ma_device captureDevice;
 float sampleBuf[FFT_SIZE * 2];
 
+// single producer (device thread), single consumer (FFT_GetFFT) sample ring,
+// the device thread publishes ringWrite after the samples are in place
+#define FFT_WINDOW (FFT_SIZE * 2)
+#define FFT_RING_SIZE (FFT_SIZE * 8)
+#define FFT_RING_CHUNK FFT_SIZE
+
+#if (FFT_SIZE & (FFT_SIZE - 1)) != 0
+#error FFT_SIZE must be a power of two
+#endif
+
+float ringBuf[FFT_RING_SIZE];
+volatile ma_uint32 ringWrite;
+ma_uint32 ringRead;
+volatile ma_uint32 fftOverruns;
+volatile ma_uint32 fftUnderruns;
+
+// the spectrum only changes when the device delivers new samples
+float magnitudes[FFT_SIZE];
+float magnitudesPeak;
+
 void miniaudioLogCallback(void* userData, ma_uint32 level, const char* message)
 {
     FFT_DebugLog(FFT_LOG_TRACE, "miniaudioLogCallback got called\n");
@@ -47,21 +67,68 @@ void miniaudioLogCallback(void* userData, ma_uint32 level, const char* message)
 
 void OnReceiveFrames(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount)
 {
-    frameCount = frameCount < FFT_SIZE * 2 ? frameCount : FFT_SIZE * 2;
-
-    // Just rotate the buffer; copy existing, append new
     const float* samples = (const float*)pInput;
-    float* p = sampleBuf;
-    for (int i = 0; i < FFT_SIZE * 2 - frameCount; i++)
+    ma_uint32 write = ma_atomic_load_explicit_32(&ringWrite, ma_atomic_memory_order_relaxed);
+
+    // a burst larger than the ring can't be read anyway, keep the newest samples
+    if (frameCount > FFT_RING_SIZE)
     {
-        *(p++) = sampleBuf[i + frameCount];
+        ma_atomic_fetch_add_explicit_32(&fftOverruns, 1, ma_atomic_memory_order_relaxed);
+        samples += (frameCount - FFT_RING_SIZE) * 2;
+        frameCount = FFT_RING_SIZE;
     }
-    for (int i = 0; i < frameCount; i++)
+
+    // publish in chunks so the consumer knows how far ahead an unpublished write can reach
+    while (frameCount)
     {
-        *(p++) = (samples[i * 2] + samples[i * 2 + 1]) / 2.0f;
+        ma_uint32 count = frameCount < FFT_RING_CHUNK ? frameCount : FFT_RING_CHUNK;
+
+        for (ma_uint32 i = 0; i < count; i++, samples += 2)
+        {
+            ringBuf[(write + i) & (FFT_RING_SIZE - 1)] = (samples[0] + samples[1]) / 2.0f;
+        }
+
+        write += count;
+        frameCount -= count;
+        ma_atomic_store_explicit_32(&ringWrite, write, ma_atomic_memory_order_release);
     }
 }
 
+// copies the newest FFT_WINDOW samples out of the ring, false if nothing arrived since the last call
+static bool readWindow()
+{
+    for (int attempt = 0; attempt < 2; attempt++)
+    {
+        ma_uint32 write = ma_atomic_load_explicit_32(&ringWrite, ma_atomic_memory_order_acquire);
+
+        if (write == ringRead)
+        {
+            ma_atomic_fetch_add_explicit_32(&fftUnderruns, 1, ma_atomic_memory_order_relaxed);
+            return false;
+        }
+
+        ma_uint32 start = write - FFT_WINDOW;
+        for (ma_uint32 i = 0; i < FFT_WINDOW; i++)
+        {
+            sampleBuf[i] = ringBuf[(start + i) & (FFT_RING_SIZE - 1)];
+        }
+
+        // the producer may be one chunk ahead of what it published,
+        // if that reached the start of our window the copy is torn
+        ma_uint32 ahead = ma_atomic_load_explicit_32(&ringWrite, ma_atomic_memory_order_acquire) - write;
+        if (ahead + FFT_RING_CHUNK <= FFT_RING_SIZE - FFT_WINDOW)
+        {
+            ringRead = write;
+            return true;
+        }
+
+        ma_atomic_fetch_add_explicit_32(&fftOverruns, 1, ma_atomic_memory_order_relaxed);
+    }
+
+    // keep the previous spectrum rather than a torn one
+    return false;
+}
+
 void print_device_id(ma_device_id id, ma_backend backend)
 {
     switch (backend)
@@ -185,9 +252,23 @@ bool FFT_Open(bool CapturePlaybackDevices, const char* CaptureDeviceSearchString
 #else
 
     memset(sampleBuf, 0, sizeof(float) * FFT_SIZE * 2);
+    memset(ringBuf, 0, sizeof ringBuf);
+    memset(magnitudes, 0, sizeof magnitudes);
+    magnitudesPeak = 0.0f;
+    ringWrite = ringRead = 0;
+    fftOverruns = fftUnderruns = 0;
 
     fftcfg = kiss_fftr_alloc(FFT_SIZE * 2, false, NULL, NULL);
 
+    // log-frequency bands, every band is at least one bin wide
+    for (int i = 1; i <= FFT_BANDS; i++)
+    {
+        int bin = (int)pow(FFT_SIZE, (double)i / FFT_BANDS);
+        bin = bin > fftBands[i - 1] ? bin : fftBands[i - 1] + 1;
+        fftBands[i] = bin < FFT_SIZE ? bin : FFT_SIZE;
+    }
+    fftBands[FFT_BANDS] = FFT_SIZE;
+
     ma_context_config context_config = ma_context_config_init();
     ma_log log;
     ma_log_init(NULL, &log);
@@ -327,15 +408,24 @@ void FFT_GetFFT(float* _samples)
     return;
 #else
 
-    kiss_fft_cpx out[FFT_SIZE + 1];
-    kiss_fftr(fftcfg, sampleBuf, out);
+    if (readWindow())
+    {
+        kiss_fft_cpx out[FFT_SIZE + 1];
+        kiss_fftr(fftcfg, sampleBuf, out);
+
+        magnitudesPeak = 0.0f;
+        for (int i = 0; i < FFT_SIZE; i++)
+        {
+            float val = 2.0f * sqrtf(out[i].r * out[i].r + out[i].i * out[i].i);
+            if (val > magnitudesPeak) magnitudesPeak = val;
+            magnitudes[i] = val;
+        }
+    }
 
-    float peakValue = fPeakMinValue;
+    float peakValue = magnitudesPeak > fPeakMinValue ? magnitudesPeak : fPeakMinValue;
     for (int i = 0; i < FFT_SIZE; i++)
     {
-        float val = 2.0f * sqrtf(out[i].r * out[i].r + out[i].i * out[i].i);
-        if (val > peakValue) peakValue = val;
-        _samples[i] = val * fAmplification;
+        _samples[i] = magnitudes[i] * fAmplification;
     }
     if (peakValue > fPeakSmoothValue)
     {
@@ -351,6 +441,8 @@ void FFT_GetFFT(float* _samples)
     for (int i = 0; i < FFT_SIZE; i++)
     {
         fftSmoothingData[i] = fftSmoothingData[i] * fFFTSmoothingFactor + (1 - fFFTSmoothingFactor) * _samples[i];
+        fftSums[i + 1] = fftSums[i] + _samples[i];
+        fftSmoothingSums[i + 1] = fftSmoothingSums[i] + fftSmoothingData[i];
     }
 
     return;
@@ -411,30 +503,59 @@ double fft(s32 startFreq, s32 endFreq, bool smoothing)
             endFreq = startFreq;
         }
 
-        double sum = 0.0;
-        for (int i = startFreq; i <= endFreq; i++)
-        {
-            sum += smoothing ? fftSmoothingData[i] : fftData[i];
-        }
-        return sum;
+        const double* sums = smoothing ? fftSmoothingSums : fftSums;
+        return sums[endFreq + 1] - sums[startFreq];
     }
 #endif
 }
 
-double tic_api_fft(tic_mem* memory, s32 startFreq, s32 endFreq)
+void FFT_GetStats(uint32_t* overruns, uint32_t* underruns)
+{
+#ifdef TIC80_FFT_UNSUPPORTED
+    *overruns = *underruns = 0;
+#else
+    *overruns = ma_atomic_load_explicit_32(&fftOverruns, ma_atomic_memory_order_relaxed);
+    *underruns = ma_atomic_load_explicit_32(&fftUnderruns, ma_atomic_memory_order_relaxed);
+#endif
+}
+
+double FFT_GetBands(int startBand, int endBand, bool smoothing)
+{
+#ifdef TIC80_FFT_UNSUPPORTED
+    return 0.0;
+#else
+    if (endBand == -1)
+        endBand = startBand;
+
+    if (!fftEnabled || (startBand < 0 && endBand < 0) || (startBand >= FFT_BANDS && endBand >= FFT_BANDS))
+        return 0.0;
+
+    startBand = startBand < 0 ? 0 : startBand < FFT_BANDS ? startBand : FFT_BANDS - 1;
+    endBand = endBand < startBand ? startBand : endBand < FFT_BANDS ? endBand : FFT_BANDS - 1;
+
+    const double* sums = smoothing ? fftSmoothingSums : fftSums;
+    return sums[fftBands[endBand + 1]] - sums[fftBands[startBand]];
+#endif
+}
+
+double tic_api_fft(tic_mem* memory, s32 startFreq, s32 endFreq, bool bands)
 {
 #ifdef TIC80_FFT_UNSUPPORTED
     return 0.0;
 #else
-    return fft(startFreq, endFreq, false);
+    return bands
+        ? FFT_GetBands(startFreq, endFreq, false)
+        : fft(startFreq, endFreq, false);
 #endif
 }
 
-double tic_api_ffts(tic_mem* memory, s32 startFreq, s32 endFreq)
+double tic_api_ffts(tic_mem* memory, s32 startFreq, s32 endFreq, bool bands)
 {
 #ifdef TIC80_FFT_UNSUPPORTED
     return 0.0;
 #else
-    return fft(startFreq, endFreq, true);
+    return bands
+        ? FFT_GetBands(startFreq, endFreq, true)
+        : fft(startFreq, endFreq, true);
 #endif
 }
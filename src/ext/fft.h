@@ -1,11 +1,15 @@
 #pragma once
 #include <stdbool.h>
+#include <stdint.h>
 
 //////////////////////////////////////////////////////////////////////////
 
 bool FFT_Open(bool CapturePlaybackDevices, const char* CaptureDeviceSearchString);
 void FFT_EnumerateDevices();
 void FFT_GetFFT(float* _samples);
+// sum of the log-frequency bands from startBand to endBand (-1 for a single band)
+double FFT_GetBands(int startBand, int endBand, bool smoothing);
+void FFT_GetStats(uint32_t* overruns, uint32_t* underruns);
 void FFT_Close();
 
 //////////////////////////////////////////////////////////////////////////
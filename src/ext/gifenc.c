@@ -0,0 +1,451 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gifenc.h"
+#include "thread.h"
+#include "defines.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define RING_SIZE 8
+#define OUTPUT_SIZE (64 * 1024)
+#define MAX_COLORS 256
+#define COLOR_HASH_SIZE 1024
+#define LZW_MAX_CODE 4095
+#define LZW_HASH_SIZE 5003
+
+typedef struct
+{
+    u32* pixels;
+    s32 delay;
+} Frame;
+
+struct gif_encoder
+{
+    s32 width;
+    s32 height;
+    s32 scale;
+
+    gif_write_callback write;
+    void* data;
+    bool error;
+
+    struct
+    {
+        Frame frames[RING_SIZE];
+        s32 head;
+        s32 tail;
+        s32 count;
+        bool done;
+    } ring;
+
+    tic_thread* thread;
+    tic_mutex* mutex;
+    tic_cond* cond;
+
+    // everything below is touched by the worker thread only
+    u8* indices;
+
+    struct
+    {
+        u32 colors[MAX_COLORS];
+        s32 count;
+
+        u32 keys[COLOR_HASH_SIZE];
+        u8 values[COLOR_HASH_SIZE];
+        bool used[COLOR_HASH_SIZE];
+    } palette;
+
+    struct
+    {
+        u32 keys[LZW_HASH_SIZE];
+        u16 codes[LZW_HASH_SIZE];
+
+        u32 bits;
+        s32 count;
+        s32 size;
+
+        u8 block[256];
+        s32 blockSize;
+    } lzw;
+
+    u8 output[OUTPUT_SIZE];
+    s32 outputSize;
+};
+
+static void flushOutput(gif_encoder* gif)
+{
+    if(gif->outputSize && !gif->error)
+        gif->error = !gif->write(gif->output, gif->outputSize, gif->data);
+
+    gif->outputSize = 0;
+}
+
+static void writeBytes(gif_encoder* gif, const void* buffer, s32 size)
+{
+    if(gif->outputSize + size > OUTPUT_SIZE)
+        flushOutput(gif);
+
+    memcpy(gif->output + gif->outputSize, buffer, size);
+    gif->outputSize += size;
+}
+
+static void writeByte(gif_encoder* gif, u8 value)
+{
+    writeBytes(gif, &value, 1);
+}
+
+static void writeWord(gif_encoder* gif, u16 value)
+{
+    writeByte(gif, value & 0xff);
+    writeByte(gif, value >> 8);
+}
+
+static inline u32 hashColor(u32 color)
+{
+    return (color * 2654435761u) >> 22;
+}
+
+static u8 nearestColor(gif_encoder* gif, u32 color)
+{
+    const u8* c = (const u8*)&color;
+    s32 min = -1;
+    u8 index = 0;
+
+    for(s32 i = 0; i < gif->palette.count; i++)
+    {
+        const u8* p = (const u8*)&gif->palette.colors[i];
+        s32 r = c[0] - p[0], g = c[1] - p[1], b = c[2] - p[2];
+        s32 dist = r * r + g * g + b * b;
+
+        if(min < 0 || dist < min)
+            min = dist, index = i;
+    }
+
+    return index;
+}
+
+static u8 colorIndex(gif_encoder* gif, u32 color)
+{
+    for(u32 h = hashColor(color);; h = (h + 1) & (COLOR_HASH_SIZE - 1))
+    {
+        if(!gif->palette.used[h])
+        {
+            u8 index;
+
+            // a frame normally has up to 32 colors (16 per vbank), more can
+            // only come from palette changes in SCN(), map them to the nearest one
+            if(gif->palette.count < MAX_COLORS)
+                gif->palette.colors[index = gif->palette.count++] = color;
+            else index = nearestColor(gif, color);
+
+            gif->palette.used[h] = true;
+            gif->palette.keys[h] = color;
+            gif->palette.values[h] = index;
+            return index;
+        }
+
+        if(gif->palette.keys[h] == color)
+            return gif->palette.values[h];
+    }
+}
+
+static void mapFrame(gif_encoder* gif, const u32* pixels)
+{
+    memset(gif->palette.used, 0, sizeof gif->palette.used);
+    gif->palette.count = 0;
+
+    const u32* src = pixels;
+    const u32* end = pixels + gif->width * gif->height;
+    u8* dst = gif->indices;
+
+    u32 last = ~*src;
+    u8 index = 0;
+
+    for(; src != end; src++)
+    {
+        if(*src != last)
+            index = colorIndex(gif, last = *src);
+
+        *dst++ = index;
+    }
+}
+
+static void flushBlock(gif_encoder* gif)
+{
+    if(gif->lzw.blockSize)
+    {
+        writeByte(gif, gif->lzw.blockSize);
+        writeBytes(gif, gif->lzw.block, gif->lzw.blockSize);
+        gif->lzw.blockSize = 0;
+    }
+}
+
+static void putCode(gif_encoder* gif, u32 code, s32 size)
+{
+    gif->lzw.bits |= code << gif->lzw.count;
+    gif->lzw.count += size;
+
+    while(gif->lzw.count >= 8)
+    {
+        gif->lzw.block[gif->lzw.blockSize++] = gif->lzw.bits & 0xff;
+        gif->lzw.bits >>= 8;
+        gif->lzw.count -= 8;
+
+        if(gif->lzw.blockSize == 255)
+            flushBlock(gif);
+    }
+}
+
+static void encodeFrame(gif_encoder* gif, const u32* pixels, s32 delay)
+{
+    mapFrame(gif, pixels);
+
+    s32 bits = 1;
+    while((1 << bits) < gif->palette.count)
+        bits++;
+
+    s32 width = gif->width * gif->scale;
+    s32 height = gif->height * gif->scale;
+
+    // graphic control extension
+    writeBytes(gif, (u8[]){0x21, 0xf9, 0x04, 0x00}, 4);
+    writeWord(gif, delay);
+    writeBytes(gif, (u8[]){0x00, 0x00}, 2);
+
+    // image descriptor with a local color table
+    writeByte(gif, 0x2c);
+    writeWord(gif, 0);
+    writeWord(gif, 0);
+    writeWord(gif, width);
+    writeWord(gif, height);
+    writeByte(gif, 0x80 | (bits - 1));
+
+    for(s32 i = 0; i < 1 << bits; i++)
+    {
+        const u8* c = (const u8*)&gif->palette.colors[i];
+        writeBytes(gif, i < gif->palette.count ? c : (u8[]){0, 0, 0}, 3);
+    }
+
+    s32 minCodeSize = MAX(bits, 2);
+    writeByte(gif, minCodeSize);
+
+    const u32 clear = 1 << minCodeSize;
+    const u32 eoi = clear + 1;
+    u32 next = eoi + 1;
+    s32 size = minCodeSize + 1;
+
+    memset(gif->lzw.keys, 0, sizeof gif->lzw.keys);
+    gif->lzw.bits = gif->lzw.count = gif->lzw.blockSize = 0;
+
+    putCode(gif, clear, size);
+
+    u32 prefix = gif->indices[0];
+    bool first = true;
+
+    // the image is upscaled on the fly, every index is repeated `scale` times
+    // and every row is fed `scale` times to the compressor
+    for(s32 y = 0; y < gif->height; y++)
+    {
+        const u8* row = gif->indices + y * gif->width;
+
+        for(s32 sy = 0; sy < gif->scale; sy++)
+        {
+            for(s32 x = 0; x < gif->width; x++)
+            {
+                for(s32 sx = 0; sx < gif->scale; sx++)
+                {
+                    if(first)
+                    {
+                        first = false;
+                        continue;
+                    }
+
+                    u32 pixel = row[x];
+                    u32 key = (prefix << 8 | pixel) + 1;
+                    u32 h = (pixel << 12 ^ prefix) % LZW_HASH_SIZE;
+
+                    while(gif->lzw.keys[h] && gif->lzw.keys[h] != key)
+                        h = (h + 1) % LZW_HASH_SIZE;
+
+                    if(gif->lzw.keys[h])
+                    {
+                        prefix = gif->lzw.codes[h];
+                        continue;
+                    }
+
+                    putCode(gif, prefix, size);
+
+                    if(next > (1u << size) - 1 && size < 12)
+                        size++;
+
+                    if(next >= LZW_MAX_CODE)
+                    {
+                        putCode(gif, clear, size);
+                        memset(gif->lzw.keys, 0, sizeof gif->lzw.keys);
+                        next = eoi + 1;
+                        size = minCodeSize + 1;
+                    }
+                    else
+                    {
+                        gif->lzw.keys[h] = key;
+                        gif->lzw.codes[h] = next++;
+                    }
+
+                    prefix = pixel;
+                }
+            }
+        }
+    }
+
+    putCode(gif, prefix, size);
+    if(next > (1u << size) - 1 && size < 12)
+        size++;
+
+    putCode(gif, eoi, size);
+
+    if(gif->lzw.count)
+        putCode(gif, 0, 8 - gif->lzw.count);
+
+    flushBlock(gif);
+    writeByte(gif, 0);
+}
+
+static s32 encodeThread(void* data)
+{
+    gif_encoder* gif = data;
+
+    for(;;)
+    {
+        tic_mutex_lock(gif->mutex);
+        while(gif->ring.count == 0 && !gif->ring.done)
+            tic_cond_wait(gif->cond, gif->mutex);
+
+        if(gif->ring.count == 0)
+        {
+            tic_mutex_unlock(gif->mutex);
+            break;
+        }
+
+        Frame* frame = &gif->ring.frames[gif->ring.tail];
+        tic_mutex_unlock(gif->mutex);
+
+        encodeFrame(gif, frame->pixels, frame->delay);
+
+        tic_mutex_lock(gif->mutex);
+        gif->ring.tail = (gif->ring.tail + 1) % RING_SIZE;
+        gif->ring.count--;
+        tic_cond_broadcast(gif->cond);
+        tic_mutex_unlock(gif->mutex);
+    }
+
+    return 0;
+}
+
+gif_encoder* gif_encoder_create(s32 width, s32 height, s32 scale, gif_write_callback write, void* data)
+{
+    gif_encoder* gif = calloc(1, sizeof(gif_encoder));
+
+    *gif = (gif_encoder)
+    {
+        .width = width,
+        .height = height,
+        .scale = MAX(scale, 1),
+        .write = write,
+        .data = data,
+        .indices = malloc(width * height),
+    };
+
+    writeBytes(gif, "GIF89a", 6);
+    writeWord(gif, width * gif->scale);
+    writeWord(gif, height * gif->scale);
+    writeBytes(gif, (u8[]){0x00, 0x00, 0x00}, 3);
+
+    // loop forever
+    writeBytes(gif, (u8[]){0x21, 0xff, 0x0b}, 3);
+    writeBytes(gif, "NETSCAPE2.0", 11);
+    writeBytes(gif, (u8[]){0x03, 0x01, 0x00, 0x00, 0x00}, 5);
+
+    gif->mutex = tic_mutex_create();
+    gif->cond = tic_cond_create();
+
+    if((gif->thread = tic_thread_create(encodeThread, gif)))
+        for(s32 i = 0; i < RING_SIZE; i++)
+            gif->ring.frames[i].pixels = malloc(width * height * sizeof(u32));
+
+    return gif;
+}
+
+void gif_encoder_frame(gif_encoder* gif, const u32* pixels, s32 delay)
+{
+    if(!gif->thread)
+    {
+        encodeFrame(gif, pixels, delay);
+        return;
+    }
+
+    tic_mutex_lock(gif->mutex);
+    while(gif->ring.count == RING_SIZE)
+        tic_cond_wait(gif->cond, gif->mutex);
+
+    Frame* frame = &gif->ring.frames[gif->ring.head];
+    tic_mutex_unlock(gif->mutex);
+
+    // the slot is not visible to the worker until count is increased
+    memcpy(frame->pixels, pixels, gif->width * gif->height * sizeof(u32));
+    frame->delay = delay;
+
+    tic_mutex_lock(gif->mutex);
+    gif->ring.head = (gif->ring.head + 1) % RING_SIZE;
+    gif->ring.count++;
+    tic_cond_broadcast(gif->cond);
+    tic_mutex_unlock(gif->mutex);
+}
+
+bool gif_encoder_close(gif_encoder* gif)
+{
+    if(gif->thread)
+    {
+        tic_mutex_lock(gif->mutex);
+        gif->ring.done = true;
+        tic_cond_broadcast(gif->cond);
+        tic_mutex_unlock(gif->mutex);
+
+        tic_thread_join(gif->thread);
+
+        for(s32 i = 0; i < RING_SIZE; i++)
+            free(gif->ring.frames[i].pixels);
+    }
+
+    writeByte(gif, 0x3b);
+    flushOutput(gif);
+
+    bool done = !gif->error;
+
+    tic_cond_free(gif->cond);
+    tic_mutex_free(gif->mutex);
+    free(gif->indices);
+    free(gif);
+
+    return done;
+}
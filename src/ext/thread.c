@@ -0,0 +1,346 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "thread.h"
+#include "tic80_config.h"
+
+#include <stdlib.h>
+
+#if defined(TIC80_THREADS)
+
+#if defined(__TIC_WINDOWS__)
+
+#include <windows.h>
+
+struct tic_thread
+{
+    HANDLE handle;
+    tic_thread_func func;
+    void* data;
+    s32 result;
+};
+
+struct tic_mutex { CRITICAL_SECTION cs; };
+struct tic_cond { CONDITION_VARIABLE cv; };
+
+static DWORD WINAPI threadProc(LPVOID param)
+{
+    tic_thread* thread = param;
+    thread->result = thread->func(thread->data);
+    return 0;
+}
+
+tic_thread* tic_thread_create(tic_thread_func func, void* data)
+{
+    tic_thread* thread = malloc(sizeof(tic_thread));
+    *thread = (tic_thread){.func = func, .data = data};
+
+    if((thread->handle = CreateThread(NULL, 0, threadProc, thread, 0, NULL)) == NULL)
+    {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+s32 tic_thread_join(tic_thread* thread)
+{
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+
+    s32 result = thread->result;
+    free(thread);
+    return result;
+}
+
+s32 tic_thread_count()
+{
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+}
+
+tic_mutex* tic_mutex_create()
+{
+    tic_mutex* mutex = malloc(sizeof(tic_mutex));
+    InitializeCriticalSection(&mutex->cs);
+    return mutex;
+}
+
+void tic_mutex_lock(tic_mutex* mutex)    { EnterCriticalSection(&mutex->cs); }
+void tic_mutex_unlock(tic_mutex* mutex)  { LeaveCriticalSection(&mutex->cs); }
+
+void tic_mutex_free(tic_mutex* mutex)
+{
+    DeleteCriticalSection(&mutex->cs);
+    free(mutex);
+}
+
+tic_cond* tic_cond_create()
+{
+    tic_cond* cond = malloc(sizeof(tic_cond));
+    InitializeConditionVariable(&cond->cv);
+    return cond;
+}
+
+void tic_cond_wait(tic_cond* cond, tic_mutex* mutex)    { SleepConditionVariableCS(&cond->cv, &mutex->cs, INFINITE); }
+void tic_cond_signal(tic_cond* cond)                    { WakeConditionVariable(&cond->cv); }
+void tic_cond_broadcast(tic_cond* cond)                 { WakeAllConditionVariable(&cond->cv); }
+void tic_cond_free(tic_cond* cond)                      { free(cond); }
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+
+struct tic_thread
+{
+    pthread_t handle;
+    tic_thread_func func;
+    void* data;
+    s32 result;
+};
+
+struct tic_mutex { pthread_mutex_t mutex; };
+struct tic_cond { pthread_cond_t cond; };
+
+static void* threadProc(void* param)
+{
+    tic_thread* thread = param;
+    thread->result = thread->func(thread->data);
+    return NULL;
+}
+
+tic_thread* tic_thread_create(tic_thread_func func, void* data)
+{
+    tic_thread* thread = malloc(sizeof(tic_thread));
+    *thread = (tic_thread){.func = func, .data = data};
+
+    if(pthread_create(&thread->handle, NULL, threadProc, thread) != 0)
+    {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+s32 tic_thread_join(tic_thread* thread)
+{
+    pthread_join(thread->handle, NULL);
+
+    s32 result = thread->result;
+    free(thread);
+    return result;
+}
+
+s32 tic_thread_count()
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (s32)count : 1;
+}
+
+tic_mutex* tic_mutex_create()
+{
+    tic_mutex* mutex = malloc(sizeof(tic_mutex));
+    pthread_mutex_init(&mutex->mutex, NULL);
+    return mutex;
+}
+
+void tic_mutex_lock(tic_mutex* mutex)    { pthread_mutex_lock(&mutex->mutex); }
+void tic_mutex_unlock(tic_mutex* mutex)  { pthread_mutex_unlock(&mutex->mutex); }
+
+void tic_mutex_free(tic_mutex* mutex)
+{
+    pthread_mutex_destroy(&mutex->mutex);
+    free(mutex);
+}
+
+tic_cond* tic_cond_create()
+{
+    tic_cond* cond = malloc(sizeof(tic_cond));
+    pthread_cond_init(&cond->cond, NULL);
+    return cond;
+}
+
+void tic_cond_wait(tic_cond* cond, tic_mutex* mutex)    { pthread_cond_wait(&cond->cond, &mutex->mutex); }
+void tic_cond_signal(tic_cond* cond)                    { pthread_cond_signal(&cond->cond); }
+void tic_cond_broadcast(tic_cond* cond)                 { pthread_cond_broadcast(&cond->cond); }
+
+void tic_cond_free(tic_cond* cond)
+{
+    pthread_cond_destroy(&cond->cond);
+    free(cond);
+}
+
+#endif
+
+#else
+
+tic_thread* tic_thread_create(tic_thread_func func, void* data) { return NULL; }
+s32 tic_thread_join(tic_thread* thread) { return 0; }
+s32 tic_thread_count() { return 1; }
+
+tic_mutex* tic_mutex_create() { return NULL; }
+void tic_mutex_lock(tic_mutex* mutex) {}
+void tic_mutex_unlock(tic_mutex* mutex) {}
+void tic_mutex_free(tic_mutex* mutex) {}
+
+tic_cond* tic_cond_create() { return NULL; }
+void tic_cond_wait(tic_cond* cond, tic_mutex* mutex) {}
+void tic_cond_signal(tic_cond* cond) {}
+void tic_cond_broadcast(tic_cond* cond) {}
+void tic_cond_free(tic_cond* cond) {}
+
+#endif
+
+struct tic_pool
+{
+    tic_thread** threads;
+    s32 count;
+
+    tic_mutex* mutex;
+    tic_cond* start;
+    tic_cond* done;
+
+    // current job, guarded by the mutex
+    tic_pool_func func;
+    void* data;
+    s32 jobs;
+    s32 next;
+    s32 pending;
+    u32 generation;
+    bool quit;
+};
+
+// takes indexes until there are none left, the mutex is locked on entry and exit
+static void poolWork(tic_pool* pool)
+{
+    while(pool->next < pool->jobs)
+    {
+        s32 index = pool->next++;
+        tic_pool_func func = pool->func;
+        void* data = pool->data;
+
+        tic_mutex_unlock(pool->mutex);
+        func(index, data);
+        tic_mutex_lock(pool->mutex);
+
+        if(--pool->pending == 0)
+            tic_cond_broadcast(pool->done);
+    }
+}
+
+static s32 poolThread(void* data)
+{
+    tic_pool* pool = data;
+    u32 generation = 0;
+
+    tic_mutex_lock(pool->mutex);
+
+    for(;;)
+    {
+        while(pool->generation == generation && !pool->quit)
+            tic_cond_wait(pool->start, pool->mutex);
+
+        if(pool->quit)
+            break;
+
+        generation = pool->generation;
+        poolWork(pool);
+    }
+
+    tic_mutex_unlock(pool->mutex);
+
+    return 0;
+}
+
+tic_pool* tic_pool_create(s32 threads)
+{
+    tic_pool* pool = calloc(1, sizeof(tic_pool));
+
+    pool->mutex = tic_mutex_create();
+    pool->start = tic_cond_create();
+    pool->done = tic_cond_create();
+
+    if(threads > 0)
+    {
+        pool->threads = malloc(threads * sizeof(tic_thread*));
+
+        for(s32 i = 0; i < threads; i++)
+            if((pool->threads[pool->count] = tic_thread_create(poolThread, pool)))
+                pool->count++;
+    }
+
+    return pool;
+}
+
+void tic_pool_run(tic_pool* pool, s32 count, tic_pool_func func, void* data)
+{
+    if(pool->count == 0 || count < 2)
+    {
+        for(s32 i = 0; i < count; i++)
+            func(i, data);
+
+        return;
+    }
+
+    tic_mutex_lock(pool->mutex);
+
+    pool->func = func;
+    pool->data = data;
+    pool->jobs = count;
+    pool->next = 0;
+    pool->pending = count;
+    pool->generation++;
+    tic_cond_broadcast(pool->start);
+
+    poolWork(pool);
+
+    while(pool->pending)
+        tic_cond_wait(pool->done, pool->mutex);
+
+    tic_mutex_unlock(pool->mutex);
+}
+
+s32 tic_pool_threads(const tic_pool* pool)
+{
+    return pool->count;
+}
+
+void tic_pool_free(tic_pool* pool)
+{
+    tic_mutex_lock(pool->mutex);
+    pool->quit = true;
+    tic_cond_broadcast(pool->start);
+    tic_mutex_unlock(pool->mutex);
+
+    for(s32 i = 0; i < pool->count; i++)
+        tic_thread_join(pool->threads[i]);
+
+    free(pool->threads);
+    tic_cond_free(pool->done);
+    tic_cond_free(pool->start);
+    tic_mutex_free(pool->mutex);
+    free(pool);
+}
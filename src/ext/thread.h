@@ -0,0 +1,64 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <tic80_types.h>
+
+// Minimal threading layer: pthreads on POSIX, native threads on Windows.
+// When TIC80_THREADS is not defined, tic_thread_create() returns NULL and
+// the caller is expected to do the work synchronously; mutexes and
+// conditions become no-ops.
+
+typedef struct tic_thread tic_thread;
+typedef struct tic_mutex tic_mutex;
+typedef struct tic_cond tic_cond;
+
+typedef s32(*tic_thread_func)(void* data);
+
+tic_thread* tic_thread_create(tic_thread_func func, void* data);
+s32         tic_thread_join(tic_thread* thread);
+s32         tic_thread_count();
+
+tic_mutex*  tic_mutex_create();
+void        tic_mutex_lock(tic_mutex* mutex);
+void        tic_mutex_unlock(tic_mutex* mutex);
+void        tic_mutex_free(tic_mutex* mutex);
+
+tic_cond*   tic_cond_create();
+void        tic_cond_wait(tic_cond* cond, tic_mutex* mutex);
+void        tic_cond_signal(tic_cond* cond);
+void        tic_cond_broadcast(tic_cond* cond);
+void        tic_cond_free(tic_cond* cond);
+
+// Persistent worker pool for data-parallel jobs.
+// tic_pool_run() calls func(index, data) for every index in [0, count)
+// on the workers and the calling thread and returns when all calls are done.
+
+typedef struct tic_pool tic_pool;
+
+typedef void(*tic_pool_func)(s32 index, void* data);
+
+tic_pool*   tic_pool_create(s32 threads);
+void        tic_pool_run(tic_pool* pool, s32 count, tic_pool_func func, void* data);
+s32         tic_pool_threads(const tic_pool* pool);
+void        tic_pool_free(tic_pool* pool);
@@ -3,6 +3,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <time.h>
 
 float fPeakMinValue = 0.01f;
@@ -13,9 +14,26 @@ float fftData[FFT_SIZE] = {0};
 float fftSmoothingData[FFT_SIZE] = {0};
 float fftNormalizedData[FFT_SIZE] = {0};
 float fftNormalizedMaxData[FFT_SIZE] = {0};
+double fftSums[FFT_SIZE + 1] = {0};
+double fftSmoothingSums[FFT_SIZE + 1] = {0};
+int fftBands[FFT_BANDS + 1] = {0};
 
 bool fftEnabled = false;
 
+void FFT_ResetData()
+{
+    fPeakMinValue = 0.01f;
+    fPeakSmoothing = 0.995f;
+    fPeakSmoothValue = 0.0f;
+    fAmplification = 1.0f;
+    memset(fftData, 0, sizeof fftData);
+    memset(fftSmoothingData, 0, sizeof fftSmoothingData);
+    memset(fftNormalizedData, 0, sizeof fftNormalizedData);
+    memset(fftNormalizedMaxData, 0, sizeof fftNormalizedMaxData);
+    memset(fftSums, 0, sizeof fftSums);
+    memset(fftSmoothingSums, 0, sizeof fftSmoothingSums);
+}
+
 #define FFT_DEBUG
 
 FFT_LogLevel g_currentLogLevel = FFT_LOG_DEBUG;
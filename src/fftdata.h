@@ -1,6 +1,16 @@
 #pragma once
 #include <stdbool.h>
+
+// window size in bins, set from the build with TIC80_FFT_SIZE
+#if !defined(FFT_SIZE)
 #define FFT_SIZE 1024
+#endif
+
+// number of log-frequency bands, see FFT_GetBands() and fft(start end bands=true)
+#if !defined(FFT_BANDS)
+#define FFT_BANDS 32
+#endif
+
 extern float fPeakMinValue;
 extern float fPeakSmoothing;
 extern float fPeakSmoothValue;
@@ -10,6 +20,14 @@ extern float fftSmoothingData[FFT_SIZE];
 extern float fftNormalizedData[FFT_SIZE];
 extern float fftNormalizedMaxData[FFT_SIZE];
 
+// running sums updated once per frame,
+// the sum of bins [start, end] is sums[end + 1] - sums[start]
+extern double fftSums[FFT_SIZE + 1];
+extern double fftSmoothingSums[FFT_SIZE + 1];
+
+// first bin of every band, fftBands[FFT_BANDS] is FFT_SIZE
+extern int fftBands[FFT_BANDS + 1];
+
 extern bool fftEnabled;
 
 typedef enum
@@ -26,3 +44,4 @@ typedef enum
 extern FFT_LogLevel g_currentLogLevel;
 
 void FFT_DebugLog(FFT_LogLevel level, const char* format, ...);
+void FFT_ResetData();
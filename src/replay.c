@@ -0,0 +1,271 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "replay.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char ReplayMagic[] = "TICR";
+enum {ReplayVersion = 1, HeaderSize = STRLEN(ReplayMagic) + 1};
+
+enum
+{
+    FieldGamepads   = 1 << 0,
+    FieldMouse      = 1 << 1,
+    FieldKeyboard   = 1 << 2,
+    FieldTime       = 1 << 3,
+    FieldTstamp     = 1 << 4,
+};
+
+struct tic_replay
+{
+    u8* data;
+    s32 size;
+    s32 capacity;
+    s32 pos;
+    s32 frames;
+
+    tic_replay_frame last;
+    u64 delta;
+};
+
+static void reserve(tic_replay* replay, s32 size)
+{
+    if(replay->size + size > replay->capacity)
+    {
+        replay->capacity = MAX(replay->capacity * 2, replay->size + size);
+        replay->data = realloc(replay->data, replay->capacity);
+    }
+}
+
+static inline void putByte(tic_replay* replay, u8 value)
+{
+    replay->data[replay->size++] = value;
+}
+
+static void putU32(tic_replay* replay, u32 value)
+{
+    for(s32 i = 0; i < sizeof value; i++)
+        putByte(replay, value >> (i * BITS_IN_BYTE));
+}
+
+static void putVarint(tic_replay* replay, u64 value)
+{
+    do
+    {
+        u8 byte = value & 0x7f;
+        value >>= 7;
+        putByte(replay, value ? byte | 0x80 : byte);
+    }
+    while(value);
+}
+
+static inline u64 zigzag(s64 value)
+{
+    return ((u64)value << 1) ^ (u64)(value >> 63);
+}
+
+static inline s64 unzigzag(u64 value)
+{
+    return (s64)(value >> 1) ^ -(s64)(value & 1);
+}
+
+static bool getByte(tic_replay* replay, u8* value)
+{
+    if(replay->pos < replay->size)
+    {
+        *value = replay->data[replay->pos++];
+        return true;
+    }
+
+    return false;
+}
+
+static bool getU32(tic_replay* replay, u32* value)
+{
+    *value = 0;
+
+    for(s32 i = 0; i < sizeof *value; i++)
+    {
+        u8 byte;
+        if(!getByte(replay, &byte))
+            return false;
+
+        *value |= (u32)byte << (i * BITS_IN_BYTE);
+    }
+
+    return true;
+}
+
+static bool getVarint(tic_replay* replay, u64* value)
+{
+    *value = 0;
+
+    for(s32 shift = 0; shift < sizeof *value * BITS_IN_BYTE; shift += 7)
+    {
+        u8 byte;
+        if(!getByte(replay, &byte))
+            return false;
+
+        *value |= (u64)(byte & 0x7f) << shift;
+
+        if(!(byte & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+static u32 mouse2u32(const tic80_mouse* mouse)
+{
+    return mouse->x | mouse->y << 8 | (u32)mouse->btns << 16;
+}
+
+static void u322mouse(tic80_mouse* mouse, u32 value)
+{
+    mouse->x = value;
+    mouse->y = value >> 8;
+    mouse->btns = value >> 16;
+}
+
+tic_replay* tic_replay_create()
+{
+    tic_replay* replay = calloc(1, sizeof(tic_replay));
+
+    reserve(replay, HeaderSize);
+    memcpy(replay->data, ReplayMagic, STRLEN(ReplayMagic));
+    replay->size = STRLEN(ReplayMagic);
+    putByte(replay, ReplayVersion);
+
+    return replay;
+}
+
+tic_replay* tic_replay_load(const void* buffer, s32 size)
+{
+    if(size < HeaderSize
+        || memcmp(buffer, ReplayMagic, STRLEN(ReplayMagic)) != 0
+        || ((const u8*)buffer)[STRLEN(ReplayMagic)] != ReplayVersion)
+        return NULL;
+
+    tic_replay* replay = calloc(1, sizeof(tic_replay));
+
+    reserve(replay, size);
+    memcpy(replay->data, buffer, size);
+    replay->size = size;
+    replay->pos = HeaderSize;
+
+    return replay;
+}
+
+void tic_replay_close(tic_replay* replay)
+{
+    free(replay->data);
+    free(replay);
+}
+
+void tic_replay_write(tic_replay* replay, const tic_replay_frame* frame)
+{
+    const tic_replay_frame* last = &replay->last;
+    u64 delta = frame->time - last->time;
+
+    u8 mask = 0;
+    if(frame->input.gamepads.data != last->input.gamepads.data)                 mask |= FieldGamepads;
+    if(mouse2u32(&frame->input.mouse) != mouse2u32(&last->input.mouse))         mask |= FieldMouse;
+    if(frame->input.keyboard.data != last->input.keyboard.data)                 mask |= FieldKeyboard;
+    if(delta != replay->delta)                                                  mask |= FieldTime;
+    if(frame->tstamp != last->tstamp)                                           mask |= FieldTstamp;
+
+    // mask + 3 raw fields + 2 varints
+    reserve(replay, 1 + 3 * sizeof(u32) + 2 * 10);
+
+    putByte(replay, mask);
+
+    if(mask & FieldGamepads)    putU32(replay, frame->input.gamepads.data);
+    if(mask & FieldMouse)       putU32(replay, mouse2u32(&frame->input.mouse));
+    if(mask & FieldKeyboard)    putU32(replay, frame->input.keyboard.data);
+    if(mask & FieldTime)        putVarint(replay, delta);
+    if(mask & FieldTstamp)      putVarint(replay, zigzag((s64)frame->tstamp - last->tstamp));
+
+    replay->delta = delta;
+    replay->last = *frame;
+    replay->frames++;
+}
+
+bool tic_replay_read(tic_replay* replay, tic_replay_frame* frame)
+{
+    tic_replay_frame next = replay->last;
+    u8 mask;
+
+    if(!getByte(replay, &mask))
+        return false;
+
+    if(mask & FieldGamepads && !getU32(replay, &next.input.gamepads.data))
+        return false;
+
+    if(mask & FieldMouse)
+    {
+        u32 mouse;
+        if(!getU32(replay, &mouse))
+            return false;
+
+        u322mouse(&next.input.mouse, mouse);
+    }
+
+    if(mask & FieldKeyboard && !getU32(replay, &next.input.keyboard.data))
+        return false;
+
+    if(mask & FieldTime && !getVarint(replay, &replay->delta))
+        return false;
+
+    if(mask & FieldTstamp)
+    {
+        u64 delta;
+        if(!getVarint(replay, &delta))
+            return false;
+
+        next.tstamp += (s32)unzigzag(delta);
+    }
+
+    next.time += replay->delta;
+
+    *frame = replay->last = next;
+    replay->frames++;
+
+    return true;
+}
+
+const u8* tic_replay_data(const tic_replay* replay, s32* size)
+{
+    *size = replay->size;
+    return replay->data;
+}
+
+s32 tic_replay_frames(const tic_replay* replay)
+{
+    return replay->frames;
+}
+
+u64 tic_replay_time(u64 counter, u64 freq)
+{
+    return counter / freq * TIC_REPLAY_FREQ + counter % freq * TIC_REPLAY_FREQ / freq;
+}
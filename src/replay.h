@@ -0,0 +1,52 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "tic.h"
+
+// recorded input replay format:
+// header: "TICR" magic, version byte
+// frame:  field mask byte followed by the changed fields only,
+//         clock values are stored as varint deltas from the previous frame
+
+#define TIC_REPLAY_FREQ 1000000 // clock is recorded in microseconds
+
+typedef struct
+{
+    tic80_input input;
+    u64 time;
+    s32 tstamp;
+} tic_replay_frame;
+
+typedef struct tic_replay tic_replay;
+
+tic_replay* tic_replay_create();
+tic_replay* tic_replay_load(const void* buffer, s32 size);
+void        tic_replay_close(tic_replay* replay);
+
+void        tic_replay_write(tic_replay* replay, const tic_replay_frame* frame);
+bool        tic_replay_read(tic_replay* replay, tic_replay_frame* frame);
+
+const u8*   tic_replay_data(const tic_replay* replay, s32* size);
+s32         tic_replay_frames(const tic_replay* replay);
+u64         tic_replay_time(u64 counter, u64 freq);
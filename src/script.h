@@ -74,7 +74,21 @@ struct tic_script
 
 typedef struct tic_script tic_script;
 
+// global callbacks found by the current runtime; a runtime that looks them up
+// resolves them again after every TIC (a cart can reassign them at any time)
+// and sets tic_script_probed, the others leave all of them set and the core
+// falls back to a scan of the source for SCN/BDR
+enum
+{
+    tic_script_scn      = 1 << 0,
+    tic_script_bdr      = 1 << 1,
+    tic_script_menu     = 1 << 2,
+    tic_script_all      = tic_script_scn | tic_script_bdr | tic_script_menu,
+    tic_script_probed   = 1 << 3,
+};
+
 const tic_script* tic_get_script(tic_mem* memory);
+u32 tic_script_callbacks(tic_mem* memory);
 void tic_add_script(const tic_script* script);
 const tic_script** tic_scripts();
 
@@ -0,0 +1,219 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "sink.h"
+#include "tools.h"
+#include "core/core.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const char SinkMagic[] = "TICS";
+enum {SinkVersion = 2, SinkVbanks = 2};
+
+enum
+{
+    HeaderSize = STRLEN(SinkMagic) + 1 + 1 + sizeof(u16) * 2 + sizeof(u32) + 1,
+    PacketHeaderSize = 1 + sizeof(u32),
+    RgbaSize = TIC80_FULLWIDTH * TIC80_FULLHEIGHT * sizeof(u32),
+    IndexedSize = SinkVbanks * sizeof(tic_palette) + 2 + SinkVbanks * 2 + SinkVbanks * sizeof(tic_screen),
+};
+
+struct tic_sink
+{
+    tic_sink_writer write;
+    void* data;
+
+    tic_sink_format format;
+    tic80_pixel_color_format pixels;
+    bool error;
+
+    u8* buffer;
+    s32 size;
+    s32 capacity;
+};
+
+static void reserve(tic_sink* sink, s32 size)
+{
+    if(sink->size + size > sink->capacity)
+    {
+        sink->capacity = MAX(sink->capacity * 2, sink->size + size);
+        sink->buffer = realloc(sink->buffer, sink->capacity);
+    }
+}
+
+static inline void putByte(tic_sink* sink, u8 value)
+{
+    sink->buffer[sink->size++] = value;
+}
+
+static inline void putBytes(tic_sink* sink, const void* data, s32 size)
+{
+    memcpy(sink->buffer + sink->size, data, size);
+    sink->size += size;
+}
+
+static void putNumber(tic_sink* sink, u32 value, s32 size)
+{
+    for(s32 i = 0; i < size; i++)
+        putByte(sink, value >> (i * BITS_IN_BYTE));
+}
+
+static void putPacket(tic_sink* sink, u8 tag, s32 size)
+{
+    reserve(sink, PacketHeaderSize + size);
+    putByte(sink, tag);
+    putNumber(sink, size, sizeof(u32));
+}
+
+static void flush(tic_sink* sink)
+{
+    if(sink->size && !sink->error && !sink->write(sink->buffer, sink->size, sink->data))
+        sink->error = true;
+
+    sink->size = 0;
+}
+
+// byte positions of R, G, B and A in a pixel of the given format
+static const u8* channelOffsets(tic80_pixel_color_format format)
+{
+    static const u8 Rgba[] = {0, 1, 2, 3}, Bgra[] = {2, 1, 0, 3}, Abgr[] = {3, 2, 1, 0}, Argb[] = {1, 2, 3, 0};
+
+    switch(format)
+    {
+    case TIC80_PIXEL_COLOR_BGRA8888: return Bgra;
+    case TIC80_PIXEL_COLOR_ABGR8888: return Abgr;
+    case TIC80_PIXEL_COLOR_ARGB8888: return Argb;
+    default: return Rgba;
+    }
+}
+
+static void putRgba(tic_sink* sink, const u32* screen)
+{
+    putPacket(sink, 'V', RgbaSize);
+
+    if(sink->pixels == TIC80_PIXEL_COLOR_RGBA8888)
+    {
+        putBytes(sink, screen, RgbaSize);
+        return;
+    }
+
+    const u8* offsets = channelOffsets(sink->pixels);
+    const u8* src = (const u8*)screen;
+    u8* dst = sink->buffer + sink->size;
+
+    for(const u8* end = src + RgbaSize; src != end; src += sizeof(u32), dst += sizeof(u32))
+    {
+        dst[0] = src[offsets[0]];
+        dst[1] = src[offsets[1]];
+        dst[2] = src[offsets[2]];
+        dst[3] = src[offsets[3]];
+    }
+
+    sink->size += RgbaSize;
+}
+
+static void putIndexed(tic_sink* sink, const tic_mem* tic)
+{
+    const tic_core* core = (const tic_core*)tic;
+
+    // vbank(1) can be left active by the cart, the banks are always written in order
+    const tic_vram* banks[SinkVbanks] =
+    {
+        core->state.vbank.id ? &core->state.vbank.mem : &tic->ram->vram,
+        core->state.vbank.id ? &tic->ram->vram : &core->state.vbank.mem,
+    };
+
+    putPacket(sink, 'V', IndexedSize);
+
+    for(s32 i = 0; i < SinkVbanks; i++)
+        putBytes(sink, &banks[i]->palette, sizeof(tic_palette));
+
+    putByte(sink, banks[0]->vars.border);
+    putByte(sink, banks[1]->vars.clear);
+
+    for(s32 i = 0; i < SinkVbanks; i++)
+    {
+        putByte(sink, banks[i]->vars.offset.x);
+        putByte(sink, banks[i]->vars.offset.y);
+    }
+
+    for(s32 i = 0; i < SinkVbanks; i++)
+        putBytes(sink, &banks[i]->screen, sizeof(tic_screen));
+}
+
+static void putAudio(tic_sink* sink, const s16* samples, s32 count)
+{
+    putPacket(sink, 'A', count * sizeof(s16));
+
+#if RETRO_IS_BIG_ENDIAN
+    for(s32 i = 0; i < count; i++)
+        putNumber(sink, (u16)samples[i], sizeof(u16));
+#else
+    putBytes(sink, samples, count * sizeof(s16));
+#endif
+}
+
+tic_sink* tic_sink_create(tic_sink_format format, tic80_pixel_color_format pixels, s32 samplerate, tic_sink_writer write, void* data)
+{
+    tic_sink* sink = calloc(1, sizeof(tic_sink));
+    sink->write = write;
+    sink->data = data;
+    sink->format = format;
+    sink->pixels = pixels;
+
+    bool indexed = format == tic_sink_indexed;
+
+    reserve(sink, HeaderSize);
+    putBytes(sink, SinkMagic, STRLEN(SinkMagic));
+    putByte(sink, SinkVersion);
+    putByte(sink, format);
+    putNumber(sink, indexed ? TIC80_WIDTH : TIC80_FULLWIDTH, sizeof(u16));
+    putNumber(sink, indexed ? TIC80_HEIGHT : TIC80_FULLHEIGHT, sizeof(u16));
+    putNumber(sink, samplerate, sizeof(u32));
+    putByte(sink, TIC80_SAMPLE_CHANNELS);
+    flush(sink);
+
+    return sink;
+}
+
+bool tic_sink_frame(tic_sink* sink, const tic_mem* tic)
+{
+    sink->format == tic_sink_indexed
+        ? putIndexed(sink, tic)
+        : putRgba(sink, tic->product.screen);
+
+    putAudio(sink, tic->product.samples.buffer, tic->product.samples.count);
+    flush(sink);
+
+    return !sink->error;
+}
+
+bool tic_sink_close(tic_sink* sink)
+{
+    bool done = !sink->error;
+
+    free(sink->buffer);
+    free(sink);
+
+    return done;
+}
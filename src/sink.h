@@ -0,0 +1,53 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "api.h"
+
+// raw audio/video stream for headless pipelines:
+// header: "TICS" magic, version byte, video format byte, width u16, height u16,
+//         samplerate u32, channels byte
+// then packets: tag byte, payload size u32, payload
+// - 'V' rgba frame: the product screen, R G B A bytes per pixel
+// - 'V' indexed frame, the same layers the blit composes:
+//   vbank0 palette, vbank1 palette, border color (vbank0),
+//   transparent color of vbank1, x/y offset s8 pairs of vbank0 and vbank1,
+//   vbank0 4bpp screen, vbank1 4bpp screen drawn over it;
+//   palette changes made from SCN() are not reproduced
+// - 'A' audio: interleaved s16 samples
+// all the numbers are little-endian, a packet is written in one go,
+// so a reader can stop at any packet boundary
+
+typedef enum
+{
+    tic_sink_rgba,
+    tic_sink_indexed,
+} tic_sink_format;
+
+typedef bool(*tic_sink_writer)(const void* buffer, s32 size, void* data);
+
+typedef struct tic_sink tic_sink;
+
+tic_sink*   tic_sink_create(tic_sink_format format, tic80_pixel_color_format pixels, s32 samplerate, tic_sink_writer write, void* data);
+bool        tic_sink_frame(tic_sink* sink, const tic_mem* tic);
+bool        tic_sink_close(tic_sink* sink);
@@ -37,6 +37,8 @@
 #define INTEGER_SCALE_DEFAULT true
 #endif
 
+#define DEFAULT_WATCH_INTERVAL 500 // ms, used where file change events are not available
+
 #define JSON(...) #__VA_ARGS__
 
 static void readConfig(Config* config)
@@ -49,10 +51,16 @@ static void readConfig(Config* config)
         config->data.uiScale = json_int("UI_SCALE", 0);
         config->data.soft = json_bool("SOFTWARE_RENDERING", 0);
         config->data.trim = json_bool("TRIM_ON_SAVE", 0);
+        config->data.codeCache = !json_bool("DISABLE_CODE_CACHE", 0);
 
         if(config->data.uiScale <= 0)
             config->data.uiScale = 1;
 
+        config->data.watchInterval = json_int("WATCH_INTERVAL", 0);
+
+        if(config->data.watchInterval <= 0)
+            config->data.watchInterval = DEFAULT_WATCH_INTERVAL;
+
         config->data.theme.gamepad.touch.alpha = json_int("GAMEPAD_TOUCH_ALPHA", 0);
 
         s32 theme = json_object("CODE_THEME", 0);
@@ -129,8 +137,10 @@ static void saveConfig(Config* config, bool overwrite)
     if(buffer)
     {
         s32 size = tic_cart_save(config->data.cart, buffer);
+        const char* path = tic_fs_pathroot(config->fs, CONFIG_TIC_PATH);
 
-        tic_fs_saveroot(config->fs, CONFIG_TIC_PATH, buffer, size, overwrite);
+        if(overwrite || !fs_exists(path))
+            fs_write_async(path, buffer, size, NULL, NULL);
 
         free(buffer);
     }
@@ -286,7 +296,7 @@ static void saveOptions(Config* config)
 #endif
         );
 
-    tic_fs_saveroot(config->fs, OptionsJsonPath, buf.data, strlen(buf.data), true);
+    fs_write_async(tic_fs_pathroot(config->fs, OptionsJsonPath), buf.data, (s32)strlen(buf.data), NULL, NULL);
 }
 
 void freeConfig(Config* config)
@@ -761,6 +761,8 @@ static void parseSyntaxColor(Code* code)
     {
         parseCode(config, code->src, code->state);
     }
+
+    code->outline.dirty = true;
 }
 
 static char* getLineByPos(Code* code, char* pos)
@@ -1700,7 +1702,45 @@ static int funcCompare(const void* a, const void* b)
     const tic_outline_item* item1 = (const tic_outline_item*)a;
     const tic_outline_item* item2 = (const tic_outline_item*)b;
 
-    return strcmp(item1->pos, item2->pos);
+    s32 res = strncmp(item1->pos, item2->pos, MIN(item1->size, item2->size));
+
+    return res ? res : item1->size - item2->size;
+}
+
+static const tic_outline_item* getOutline(Code* code, s32* size)
+{
+    if(code->outline.dirty)
+    {
+        code->outline.dirty = false;
+        code->outline.size = 0;
+
+        const tic_script* config = tic_get_script(code->tic);
+
+        if(config && config->getOutline)
+        {
+            s32 count = 0;
+            const tic_outline_item* items = config->getOutline(code->src, &count);
+
+            if(items && count)
+            {
+                tic_outline_item* outline = realloc(code->outline.items, count * sizeof(tic_outline_item));
+
+                if(outline)
+                {
+                    code->outline.items = outline;
+
+                    for(const tic_outline_item *it = items, *end = items + count; it != end; ++it)
+                        if(code->state[it->pos - code->src].syntax != SyntaxType_COMMENT)
+                            outline[code->outline.size++] = *it;
+
+                    qsort(outline, code->outline.size, sizeof(tic_outline_item), funcCompare);
+                }
+            }
+        }
+    }
+
+    *size = code->outline.size;
+    return code->outline.items;
 }
 
 static void normalizeScroll(Code* code)
@@ -1764,13 +1804,50 @@ static void updateSidebarCode(Code* code)
     updateEditor(code);
 }
 
-static bool isFilterMatch(const char* buffer, s32 size, const char* filter)
+// ranks a subsequence match of the filter, matches at the start of the name,
+// at the start of a word and right after the previous match count more,
+// returns -1 if the filter doesn't match
+static s32 getFilterScore(Code* code, const char* buffer, s32 size, const char* filter)
 {
-    while(size--)
-        if(tolower(*buffer++) == tolower(*filter))
-            filter++;
+    s32 score = 0;
+    const char* prev = NULL;
+
+    for(const char* ptr = buffer, *end = buffer + size; ptr != end && *filter; ptr++)
+    {
+        if(tolower(*ptr) != tolower(*filter))
+            continue;
+
+        score++;
+
+        if(ptr == buffer)
+            score += 8;
+        else if(!isalnum_(code, ptr[-1]) || (isupper(ptr[0]) && islower(ptr[-1])))
+            score += 4;
+
+        if(prev && prev + 1 == ptr)
+            score += 2;
 
-    return *filter == 0;
+        prev = ptr;
+        filter++;
+    }
+
+    return *filter ? -1 : score;
+}
+
+typedef struct
+{
+    tic_outline_item item;
+    s32 score;
+} ScoredItem;
+
+static int scoreCompare(const void* a, const void* b)
+{
+    const ScoredItem* item1 = (const ScoredItem*)a;
+    const ScoredItem* item2 = (const ScoredItem*)b;
+
+    return item1->score != item2->score
+        ? item2->score - item1->score
+        : funcCompare(&item1->item, &item2->item);
 }
 
 static void drawFilterMatch(Code *code, s32 x, s32 y, const char* orig, s32 size, const char* filter)
@@ -1794,33 +1871,53 @@ static void drawFilterMatch(Code *code, s32 x, s32 y, const char* orig, s32 size
 
 static void initSidebarMode(Code* code)
 {
-    tic_mem* tic = code->tic;
-
     code->sidebar.size = 0;
 
-    const tic_script* config = tic_get_script(tic);
+    s32 size = 0;
+    const tic_outline_item* items = getOutline(code, &size);
+
+    if(size == 0)
+        return;
 
-    if(config->getOutline)
+    tic_outline_item* sidebar = realloc(code->sidebar.items, size * sizeof(tic_outline_item));
+
+    if(!sidebar)
+        return;
+
+    code->sidebar.items = sidebar;
+
+    const char* filter = code->popup.text;
+
+    // the index is already sorted by name
+    if(*filter == '\0')
     {
-        s32 size = 0;
-        const tic_outline_item* items = config->getOutline(code->src, &size);
+        memcpy(sidebar, items, size * sizeof(tic_outline_item));
+        code->sidebar.size = size;
+        return;
+    }
 
-        if(items)
-        {
-            for(const tic_outline_item *it = items, *end = items + size; it != end ; ++it)
-            {
-                if(code->state[it->pos - code->src].syntax == SyntaxType_COMMENT)
-                    continue;
+    ScoredItem* scored = malloc(size * sizeof(ScoredItem));
 
-                const char* filter = code->popup.text;
-                if(*filter && !isFilterMatch(it->pos, it->size, filter))
-                    continue;
+    if(scored)
+    {
+        s32 count = 0;
 
-                s32 last = code->sidebar.size++;
-                code->sidebar.items = realloc(code->sidebar.items, code->sidebar.size * sizeof(tic_outline_item));
-                code->sidebar.items[last] = *it;
-            }
+        for(const tic_outline_item *it = items, *end = items + size; it != end ; ++it)
+        {
+            s32 score = getFilterScore(code, it->pos, it->size, filter);
+
+            if(score >= 0)
+                scored[count++] = (ScoredItem){*it, score};
         }
+
+        qsort(scored, count, sizeof(ScoredItem), scoreCompare);
+
+        for(s32 i = 0; i < count; i++)
+            sidebar[i] = scored[i].item;
+
+        code->sidebar.size = count;
+
+        free(scored);
     }
 }
 
@@ -1858,8 +1955,58 @@ static void setOutlineMode(Code* code)
     code->sidebar.scroll = 0;
 
     initSidebarMode(code);
+    updateSidebarCode(code);
+}
+
+static void setUsagesMode(Code* code)
+{
+    code->sidebar.index = 0;
+    code->sidebar.scroll = 0;
+    code->sidebar.size = 0;
+
+    const char* start = code->cursor.position;
+    const char* end = code->cursor.position;
+
+    while(start > code->src && isalnum_(code, start[-1])) start--;
+    while(isalnum_(code, *end)) end++;
+
+    s32 size = (s32)(end - start);
+
+    if(size)
+    {
+        const char* line = code->src;
+
+        for(const char* ptr = code->src; *ptr; ptr++)
+        {
+            if(*ptr == '\n')
+            {
+                line = ptr + 1;
+                continue;
+            }
+
+            u8 syntax = code->state[ptr - code->src].syntax;
+
+            if(syntax == SyntaxType_COMMENT || syntax == SyntaxType_STRING)
+                continue;
+
+            if(strncmp(ptr, start, size) == 0
+                && (ptr == code->src || !isalnum_(code, ptr[-1]))
+                && !isalnum_(code, ptr[size]))
+            {
+                s32 last = code->sidebar.size++;
+                code->sidebar.items = realloc(code->sidebar.items, code->sidebar.size * sizeof(tic_outline_item));
+                tic_outline_item* item = &code->sidebar.items[last];
+
+                item->pos = line;
+                item->size = getLineSize(line);
+
+                // one item per line
+                while(ptr[1] && ptr[1] != '\n')
+                    ptr++;
+            }
+        }
+    }
 
-    qsort(code->sidebar.items, code->sidebar.size, sizeof(tic_outline_item), funcCompare);
     updateSidebarCode(code);
 }
 
@@ -1890,6 +2037,7 @@ static void setCodeMode(Code* code, s32 mode)
         case TEXT_GOTO_MODE: setGotoMode(code); break;
         case TEXT_BOOKMARK_MODE: setBookmarkMode(code); break;
         case TEXT_OUTLINE_MODE: setOutlineMode(code); break;
+        case TEXT_USAGES_MODE: setUsagesMode(code); break;
         default: break;
         }
 
@@ -2451,34 +2599,16 @@ end:
 //pass in pointer to beginnign of word and its length
 //so you can just use the word in src
 static char* findFunctionDefinition(Code* code, char* name, size_t length) {
-    char* result = NULL;
-
-    tic_mem* tic = code->tic;
-    const tic_script* config = tic_get_script(tic);
-
-    if(config->getOutline)
-    {
-        s32 osize = 0;
-        const tic_outline_item* items = config->getOutline(code->src, &osize);
+    s32 size = 0;
+    const tic_outline_item* items = getOutline(code, &size);
 
-        if(items)
-        {
-            for(size_t i = 0; i < osize; i++)
-            {
-                const tic_outline_item* it = items + i;
+    if(size == 0 || length == 0)
+        return NULL;
 
-                if(code->state[it->pos - code->src].syntax == SyntaxType_COMMENT)
-                    continue;
-                if (strncmp(name, it->pos, length) == 0)
-                {
-                    result = (char*) it->pos;
-                    break;
-                }
-            }
-        }
-    }
+    const tic_outline_item key = {name, (s32)length};
+    const tic_outline_item* item = bsearch(&key, items, size, sizeof(tic_outline_item), funcCompare);
 
-    return result;
+    return item ? (char*)item->pos : NULL;
 }
 
 
@@ -3002,6 +3132,7 @@ static void processKeyboard(Code* code)
             else if(keyWasPressed(code->studio, tic_key_g))     emacsMode ? killSelection(code) : setCodeMode(code, TEXT_GOTO_MODE);
             else if(keyWasPressed(code->studio, tic_key_b))     emacsMode ? leftColumn(code) : setCodeMode(code, TEXT_BOOKMARK_MODE);
             else if(keyWasPressed(code->studio, tic_key_o))     setCodeMode(code, TEXT_OUTLINE_MODE);
+            else if(keyWasPressed(code->studio, tic_key_u))     setCodeMode(code, TEXT_USAGES_MODE);
             else if(keyWasPressed(code->studio, tic_key_n))     downLine(code);
             else if(keyWasPressed(code->studio, tic_key_p))     upLine(code);
             else if(keyWasPressed(code->studio, tic_key_e))     endLine(code);
@@ -3753,6 +3884,7 @@ static void tick(Code* code)
     case TEXT_GOTO_MODE:    textGoToTick(code);     break;
     case TEXT_BOOKMARK_MODE:textBookmarkTick(code); break;
     case TEXT_OUTLINE_MODE: textOutlineTick(code);  break;
+    case TEXT_USAGES_MODE:  textBookmarkTick(code); break;
     }
 
     drawCodeToolbar(code);
@@ -3817,6 +3949,8 @@ void initCode(Code* code, Studio* studio)
 {
     bool firstLoad = code->state == NULL;
     FREE(code->state);
+    FREE(code->sidebar.items);
+    FREE(code->outline.items);
     freeAnim(code);
 
     if(code->history) history_delete(code->history);
@@ -3849,6 +3983,12 @@ void initCode(Code* code, Studio* studio)
             .index = 0,
             .scroll = 0,
         },
+        .outline =
+        {
+            .items = NULL,
+            .size = 0,
+            .dirty = true,
+        },
         .matchedDelim = NULL,
         .altFont = firstLoad ? getConfig(studio)->theme.code.altFont : code->altFont,
         .shadowText = getConfig(studio)->theme.code.shadow,
@@ -3885,6 +4025,8 @@ void freeCode(Code* code)
     freeAnim(code);
 
     history_delete(code->history);
+    free(code->sidebar.items);
+    free(code->outline.items);
     free(code->state);
     free(code);
 }
@@ -88,6 +88,7 @@ struct Code
         TEXT_GOTO_MODE,
         TEXT_BOOKMARK_MODE,
         TEXT_OUTLINE_MODE,
+        TEXT_USAGES_MODE,
         TEXT_REPLACE_MODE,
         TEXT_EDIT_MODE,
     } mode;
@@ -115,6 +116,15 @@ struct Code
         s32 scroll;
     } sidebar;
 
+    // outline of the whole source sorted by name,
+    // rebuilt on the first use after the code changes
+    struct
+    {
+        tic_outline_item* items;
+        s32 size;
+        bool dirty;
+    } outline;
+
     const char* matchedDelim;
     bool altFont;
     bool shadowText;
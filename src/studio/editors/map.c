@@ -35,7 +35,6 @@
 
 #define MIN_SCALE 1
 #define MAX_SCALE 4
-#define FILL_STACK_SIZE (TIC_MAP_WIDTH*TIC_MAP_HEIGHT)
 
 static void normalizeMap(s32* x, s32* y)
 {
@@ -836,119 +835,170 @@ static void processMouseSelectMode(Map* map)
 typedef struct
 {
     tic_point* data;
-    tic_point* head;
+    s32 count;
+    s32 size;
 } FillStack;
 
 static bool push(FillStack* stack, s32 x, s32 y)
 {
-    if(stack->head == NULL)
+    if(stack->count == stack->size)
     {
-        stack->head = stack->data;
-        stack->head->x = x;
-        stack->head->y = y;
+        s32 size = stack->size ? stack->size * 2 : 256;
+        tic_point* data = realloc(stack->data, size * sizeof(tic_point));
 
-        return true;
-    }
-
-    if(stack->head < (stack->data + FILL_STACK_SIZE-1))
-    {
-        stack->head++;
-        stack->head->x = x;
-        stack->head->y = y;
+        if(!data)
+            return false;
 
-        return true;
+        stack->data = data;
+        stack->size = size;
     }
 
-    return false;
+    stack->data[stack->count++] = (tic_point){x, y};
+
+    return true;
 }
 
 static bool pop(FillStack* stack, s32* x, s32* y)
 {
-    if(stack->head > stack->data)
-    {
-        *x = stack->head->x;
-        *y = stack->head->y;
+    if(stack->count == 0)
+        return false;
 
-        stack->head--;
+    tic_point* point = &stack->data[--stack->count];
+    *x = point->x;
+    *y = point->y;
 
-        return true;
-    }
+    return true;
+}
 
-    if(stack->head == stack->data)
-    {
-        *x = stack->head->x;
-        *y = stack->head->y;
+typedef struct
+{
+    s32 l;
+    s32 t;
+    s32 r;
+    s32 b;
+} FillClip;
 
-        stack->head = NULL;
+static FillClip getFillClip(Map* map)
+{
+    FillClip clip = { 0, 0, TIC_MAP_WIDTH, TIC_MAP_HEIGHT };
 
-        return true;
+    if (map->select.rect.w > 0 && map->select.rect.h > 0)
+    {
+        clip.l = map->select.rect.x;
+        clip.t = map->select.rect.y;
+        clip.r = map->select.rect.x + map->select.rect.w;
+        clip.b = map->select.rect.y + map->select.rect.h;
     }
 
-    return false;
+    // nothing is filled outside the map
+    clip.l = MAX(clip.l, 0);
+    clip.t = MAX(clip.t, 0);
+    clip.r = MIN(clip.r, TIC_MAP_WIDTH);
+    clip.b = MIN(clip.b, TIC_MAP_HEIGHT);
+
+    return clip;
 }
 
-static void fillMap(Map* map, s32 x, s32 y, u8 tile)
+static inline u8 getMapTile(const tic_map* src, s32 x, s32 y)
 {
-    if(tile == (map->sheet.rect.x + map->sheet.rect.y * TIC_SPRITESHEET_COLS)) return;
+    return x < 0 || x >= TIC_MAP_WIDTH || y < 0 || y >= TIC_MAP_HEIGHT
+        ? 0
+        : src->data[x + y * TIC_MAP_WIDTH];
+}
 
-    static FillStack stack = {NULL, NULL};
+static inline void setMapTile(tic_map* src, s32 x, s32 y, u8 tile)
+{
+    if(x >= 0 && x < TIC_MAP_WIDTH && y >= 0 && y < TIC_MAP_HEIGHT)
+        src->data[x + y * TIC_MAP_WIDTH] = tile;
+}
 
-    if(!stack.data)
-        stack.data = (tic_point*)malloc(FILL_STACK_SIZE * sizeof(tic_point));
+// the fill works on a grid of pattern sized blocks with the origin at the clicked tile,
+// a block is filled if its origin is inside the clip and all its tiles match
+typedef struct
+{
+    Map* map;
+    FillClip clip;
+    s32 x;
+    s32 y;
+    u8 tile;
+} FillGrid;
+
+static bool matchBlock(const FillGrid* grid, s32 bx, s32 by)
+{
+    const tic_rect* rect = &grid->map->sheet.rect;
+    s32 x = grid->x + bx * rect->w;
+    s32 y = grid->y + by * rect->h;
 
-    stack.head = NULL;
+    if(x < grid->clip.l || x >= grid->clip.r || y < grid->clip.t || y >= grid->clip.b)
+        return false;
 
-    static const s32 dx[4] = {0, 1, 0, -1};
-    static const s32 dy[4] = {-1, 0, 1, 0};
+    for(s32 j = 0; j < rect->h; j++)
+        for(s32 i = 0; i < rect->w; i++)
+            if(getMapTile(grid->map->src, x+i, y+j) != grid->tile)
+                return false;
 
-    if(!push(&stack, x, y)) return;
+    return true;
+}
 
-    s32 mx = map->sheet.rect.x;
-    s32 my = map->sheet.rect.y;
+static void fillBlock(const FillGrid* grid, s32 bx, s32 by)
+{
+    const tic_rect* rect = &grid->map->sheet.rect;
+    s32 x = grid->x + bx * rect->w;
+    s32 y = grid->y + by * rect->h;
 
-    struct
-    {
-        s32 l;
-        s32 t;
-        s32 r;
-        s32 b;
-    }clip = { 0, 0, TIC_MAP_WIDTH, TIC_MAP_HEIGHT };
+    for(s32 j = 0; j < rect->h; j++)
+        for(s32 i = 0; i < rect->w; i++)
+            setMapTile(grid->map->src, x+i, y+j, (rect->x+i) + (rect->y+j) * TIC_SPRITESHEET_COLS);
+}
 
-    if (map->select.rect.w > 0 && map->select.rect.h > 0)
-    {
-        clip.l = map->select.rect.x;
-        clip.t = map->select.rect.y;
-        clip.r = map->select.rect.x + map->select.rect.w;
-        clip.b = map->select.rect.y + map->select.rect.h;
-    }
+static void fillMap(Map* map, s32 x, s32 y, u8 tile)
+{
+    if(tile == (map->sheet.rect.x + map->sheet.rect.y * TIC_SPRITESHEET_COLS)) return;
 
+    FillGrid grid = {map, getFillClip(map), x, y, tile};
+    FillStack stack = {0};
 
-    while(pop(&stack, &x, &y))
-    {
-        for(s32 j = 0; j < map->sheet.rect.h; j++)
-            for(s32 i = 0; i < map->sheet.rect.w; i++)
-                tic_api_mset(map->tic, x+i, y+j, (mx+i) + (my+j) * TIC_SPRITESHEET_COLS);
+    // the clicked block is filled even if the pattern doesn't fit in it,
+    // a filled block never matches again because its origin isn't `tile` anymore
+    bool seed = true;
 
-        for(s32 i = 0; i < COUNT_OF(dx); i++)
+    if(push(&stack, 0, 0))
+    {
+        s32 bx, by;
+        while(pop(&stack, &bx, &by))
         {
-            s32 nx = x + dx[i]*map->sheet.rect.w;
-            s32 ny = y + dy[i]*map->sheet.rect.h;
+            if(!seed && !matchBlock(&grid, bx, by))
+                continue;
+
+            seed = false;
+
+            // scanline fill: fill the whole row span, then seed each matching run above and below it
+            s32 l = bx, r = bx;
+            while(matchBlock(&grid, l - 1, by)) l--;
+            while(matchBlock(&grid, r + 1, by)) r++;
+
+            for(s32 i = l; i <= r; i++)
+                fillBlock(&grid, i, by);
 
-            if(nx >= clip.l && nx < clip.r && ny >= clip.t && ny < clip.b)
+            for(s32 ny = by - 1; ny <= by + 1; ny += 2)
             {
-                bool match = true;
-                for(s32 j = 0; j < map->sheet.rect.h; j++)
-                    for(s32 i = 0; i < map->sheet.rect.w; i++)
-                        if(tic_api_mget(map->tic, nx+i, ny+j) != tile)
-                            match = false;
+                bool run = false;
 
-                if(match)
+                for(s32 i = l; i <= r; i++)
                 {
-                    if(!push(&stack, nx, ny)) return;
+                    bool match = matchBlock(&grid, i, ny);
+
+                    if(match && !run && !push(&stack, i, ny))
+                        goto done;
+
+                    run = match;
                 }
             }
         }
     }
+
+done:
+    free(stack.data);
 }
 
 static s32 moduloWrap(s32 x, s32 m)
@@ -965,34 +1015,20 @@ static void replaceTile(Map* map, s32 x, s32 y, u8 tile)
     s32 mx = map->sheet.rect.x;
     s32 my = map->sheet.rect.y;
 
-    struct
-    {
-        s32 l;
-        s32 t;
-        s32 r;
-        s32 b;
-    } clip = { 0, 0, TIC_MAP_WIDTH, TIC_MAP_HEIGHT };
-
-    if (map->select.rect.w > 0 && map->select.rect.h > 0)
-    {
-        clip.l = map->select.rect.x;
-        clip.t = map->select.rect.y;
-        clip.r = map->select.rect.x + map->select.rect.w;
-        clip.b = map->select.rect.y + map->select.rect.h;
-    }
+    FillClip clip = getFillClip(map);
 
     // for each tile in selection/full map
     for(s32 j = clip.t; j < clip.b; j++)
-        for(s32 i = clip.l; i < clip.r; i++)
-            if(tic_api_mget(map->tic, i, j) == tile)
-            {
-                // offset pattern based on click position
-                s32 oy = moduloWrap(j - y, map->sheet.rect.h);
-                s32 ox = moduloWrap(i - x, map->sheet.rect.w);
+    {
+        u8* row = map->src->data + j * TIC_MAP_WIDTH;
 
-                u8 newtile = (mx + ox) + (my + oy) * TIC_SPRITESHEET_COLS;
-                tic_api_mset(map->tic, i, j, newtile);
-            }
+        // offset pattern based on click position
+        s32 oy = moduloWrap(j - y, map->sheet.rect.h);
+
+        for(s32 i = clip.l; i < clip.r; i++)
+            if(row[i] == tile)
+                row[i] = (mx + moduloWrap(i - x, map->sheet.rect.w)) + (my + oy) * TIC_SPRITESHEET_COLS;
+    }
 }
 
 static void processMouseFillMode(Map* map)
@@ -1009,13 +1045,12 @@ static void processMouseFillMode(Map* map)
         getMouseMap(map, &tx, &ty);
 
         {
-            tic_mem* tic = map->tic;
-            map2ram(tic->ram, map->src);
-            if(tic_api_key(tic, tic_key_ctrl))
-                replaceTile(map, tx, ty, tic_api_mget(map->tic, tx, ty));
+            u8 tile = getMapTile(map->src, tx, ty);
+
+            if(tic_api_key(map->tic, tic_key_ctrl))
+                replaceTile(map, tx, ty, tile);
             else
-                fillMap(map, tx, ty, tic_api_mget(map->tic, tx, ty));
-            ram2map(tic->ram, map->src);
+                fillMap(map, tx, ty, tile);
         }
 
         history_add(map->history);
@@ -376,17 +376,55 @@ static void processSelectCanvasMouse(Sprite* sprite, s32 x, s32 y)
     }
 }
 
+// scanline fill with an explicit stack, `color` and `fill` must differ
 static void floodFill(Sprite* sprite, s32 l, s32 t, s32 r, s32 b, s32 x, s32 y, u8 color, u8 fill)
 {
-    if(tic_tilesheet_getpix(&sprite->sheet, x, y) == color)
+    tic_tilesheet* sheet = &sprite->sheet;
+
+    // a pixel is pushed at most by the span filled above and the one filled below it
+    s32 size = (r - l + 1) * (b - t + 1) * 2 + 1;
+    tic_point* stack = malloc(size * sizeof(tic_point));
+    s32 count = 0;
+
+    if(!stack)
+        return;
+
+    stack[count++] = (tic_point){x, y};
+
+    while(count)
     {
-        tic_tilesheet_setpix(&sprite->sheet, x, y, fill);
+        tic_point seed = stack[--count];
 
-        if(x > l) floodFill(sprite, l, t, r, b, x-1, y, color, fill);
-        if(x < r) floodFill(sprite, l, t, r, b, x+1, y, color, fill);
-        if(y > t) floodFill(sprite, l, t, r, b, x, y-1, color, fill);
-        if(y < b) floodFill(sprite, l, t, r, b, x, y+1, color, fill);
+        if(tic_tilesheet_getpix(sheet, seed.x, seed.y) != color)
+            continue;
+
+        s32 sl = seed.x, sr = seed.x;
+        while(sl > l && tic_tilesheet_getpix(sheet, sl - 1, seed.y) == color) sl--;
+        while(sr < r && tic_tilesheet_getpix(sheet, sr + 1, seed.y) == color) sr++;
+
+        for(s32 i = sl; i <= sr; i++)
+            tic_tilesheet_setpix(sheet, i, seed.y, fill);
+
+        for(s32 ny = seed.y - 1; ny <= seed.y + 1; ny += 2)
+        {
+            if(ny < t || ny > b)
+                continue;
+
+            bool run = false;
+
+            for(s32 i = sl; i <= sr; i++)
+            {
+                bool match = tic_tilesheet_getpix(sheet, i, ny) == color;
+
+                if(match && !run)
+                    stack[count++] = (tic_point){i, ny};
+
+                run = match;
+            }
+        }
     }
+
+    free(stack);
 }
 
 static void replaceColor(Sprite* sprite, s32 l, s32 t, s32 r, s32 b, s32 x, s32 y, u8 color, u8 fill)
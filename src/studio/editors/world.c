@@ -25,6 +25,16 @@
 
 #define PREVIEW_SIZE (TIC80_WIDTH * TIC80_HEIGHT * TIC_PALETTE_BPP / BITS_IN_BYTE)
 
+struct WorldCache
+{
+    bool valid;
+    tic_map map;
+    tic_tiles tiles;
+
+    // the most used non transparent color of every tile
+    u8 colors[TIC_BANK_SPRITES];
+};
+
 static void drawGrid(World* world)
 {
     tic_mem* tic = world->tic;
@@ -107,10 +117,33 @@ static void scanline(tic_mem* tic, s32 row, void* data)
         memcpy(&tic->ram->vram.palette, getBankPalette(world->studio, false), sizeof(tic_palette));
 }
 
+static u8 getTileColor(const tic_tile* tile)
+{
+    s32 colors[TIC_PALETTE_SIZE] = {0};
+
+    for(s32 p = 0; p < TIC_SPRITESIZE * TIC_SPRITESIZE; p++)
+    {
+        u8 color = tic_tool_peek4(tile, p);
+
+        if(color)
+            colors[color]++;
+    }
+
+    s32 max = 0;
+
+    for(s32 c = 0; c < COUNT_OF(colors); c++)
+        if(colors[c] > colors[max]) max = c;
+
+    return max;
+}
+
 void initWorld(World* world, Studio* studio, Map* map)
 {
     if(!world->preview)
-        world->preview = malloc(PREVIEW_SIZE);
+        world->preview = calloc(1, PREVIEW_SIZE);
+
+    if(!world->cache)
+        world->cache = calloc(1, sizeof(struct WorldCache));
 
     *world = (World)
     {
@@ -119,42 +152,41 @@ void initWorld(World* world, Studio* studio, Map* map)
         .map = map,
         .tick = tick,
         .preview = world->preview,
+        .cache = world->cache,
         .scanline = scanline,
     };
 
-    memset(world->preview, 0, PREVIEW_SIZE);
-    s32 colors[TIC_PALETTE_SIZE];
+    struct WorldCache* cache = world->cache;
+    const tic_map* src = getBankMap(world->studio);
+    const tic_tiles* tiles = getBankTiles(world->studio);
 
-    for(s32 i = 0; i < TIC80_WIDTH * TIC80_HEIGHT; i++)
-    {
-        u8 index = getBankMap(world->studio)->data[i];
+    // only the tiles and cells changed since the last time are redrawn
+    bool changed[TIC_BANK_SPRITES];
 
-        if(index)
+    for(s32 i = 0; i < TIC_BANK_SPRITES; i++)
+        if((changed[i] = !cache->valid || memcmp(&cache->tiles.data[i], &tiles->data[i], sizeof(tic_tile))))
         {
-            memset(colors, 0, sizeof colors);
-
-            tic_tile* tile = &getBankTiles(world->studio)->data[index];
-
-            for(s32 p = 0; p < TIC_SPRITESIZE * TIC_SPRITESIZE; p++)
-            {
-                u8 color = tic_tool_peek4(tile, p);
-
-                if(color)
-                    colors[color]++;
-            }
-
-            s32 max = 0;
+            cache->tiles.data[i] = tiles->data[i];
+            cache->colors[i] = getTileColor(&tiles->data[i]);
+        }
 
-            for(s32 c = 0; c < COUNT_OF(colors); c++)
-                if(colors[c] > colors[max]) max = c;
+    for(s32 i = 0; i < TIC80_WIDTH * TIC80_HEIGHT; i++)
+    {
+        u8 index = src->data[i];
 
-            tic_tool_poke4(world->preview, i, max);
+        if(!cache->valid || index != cache->map.data[i] || changed[index])
+        {
+            tic_tool_poke4(world->preview, i, index ? cache->colors[index] : 0);
+            cache->map.data[i] = index;
         }
     }
+
+    cache->valid = true;
 }
 
 void freeWorld(World* world)
 {
     free(world->preview);
+    free(world->cache);
     free(world);
 }
\ No newline at end of file
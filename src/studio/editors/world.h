@@ -35,6 +35,9 @@ struct World
 
     void* preview;
 
+    // the map and tiles the preview was drawn from
+    struct WorldCache* cache;
+
     void (*tick)(World* world);
     void (*scanline)(tic_mem* tic, s32 row, void* data);
 };
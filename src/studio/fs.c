@@ -24,6 +24,7 @@
 #include "fs.h"
 #include "net.h"
 #include "ext/json.h"
+#include "ext/thread.h"
 
 #if defined(BAREMETALPI) || defined(_3DS)
   #ifdef EN_DEBUG
@@ -37,6 +38,7 @@
 #include "../../circle-stdlib/libs/circle/addon/fatfs/ff.h"
 #else
 #include <dirent.h>
+#include <errno.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #endif
@@ -44,6 +46,8 @@
 #if defined(__TIC_WINDOWS__)
 #include <direct.h>
 #include <windows.h>
+#include <io.h>
+#include <fcntl.h>
 #else
 #include <unistd.h>
 #endif
@@ -52,6 +56,17 @@
 #include <emscripten.h>
 #endif
 
+#if defined(__TIC_LINUX__)
+#include <sys/inotify.h>
+#define USE_INOTIFY
+#endif
+
+#if defined(__TIC_LINUX__) || defined(__TIC_MACOSX__) || defined(__TIC_ANDROID__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#define USE_MMAP
+#endif
+
 #if defined(__TIC_WINDOWS__)
 #define SLASH_SYMBOL ('\\')
 #else
@@ -229,6 +244,8 @@ static int _wstat_win32_shim(const wchar_t* path, struct _stat* buffer)
 #endif
 #define tic_remove _wremove
 #define tic_fopen _wfopen
+#define tic_rename(from, to) (MoveFileExW(from, to, MOVEFILE_REPLACE_EXISTING) != 0)
+#define tic_fsync(file) _commit(_fileno(file))
 #define tic_mkdir(name) _wmkdir(name)
 #define tic_strncpy wcsncpy
 #define tic_strncat wcsncat
@@ -256,6 +273,8 @@ typedef char FsString;
 #define tic_stat stat
 #define tic_remove remove
 #define tic_fopen fopen
+#define tic_rename(from, to) (rename(from, to) == 0)
+#define tic_fsync(file) fsync(fileno(file))
 #define tic_mkdir(name) mkdir(name, 0777)
 #define tic_strncpy strncpy
 #define tic_strncat strncat
@@ -595,6 +614,36 @@ void tic_fs_isdir_async(tic_fs* fs, const char* name, fs_isdir_callback callback
     callback(tic_fs_isdir(fs, name), data);
 }
 
+#if !defined(BAREMETALPI)
+// creates a new file next to the target, the exclusive open makes the name unique
+// even when the main thread and the writer thread save the same path at once
+static FILE* openTempFile(const char* name, char* tmp, s32 size, const FsString** tmpString)
+{
+    static u32 counter = 0;
+
+    for(s32 i = 0; i < 16; i++)
+    {
+        snprintf(tmp, size, "%s.%u.tmp", name, counter++);
+
+        const FsString* string = utf8ToString(tmp);
+        FILE* file = tic_fopen(string, _S("wbx"));
+
+        if(file)
+        {
+            *tmpString = string;
+            return file;
+        }
+
+        freeString(string);
+
+        if(errno != EEXIST)
+            break;
+    }
+
+    return NULL;
+}
+#endif
+
 bool fs_write(const char* name, const void* buffer, s32 size)
 {
 #if defined(BAREMETALPI)
@@ -622,28 +671,213 @@ bool fs_write(const char* name, const void* buffer, s32 size)
     }
     return true;
 #else
-    const FsString* pathString = utf8ToString(name);
-    FILE* file = tic_fopen(pathString, _S("wb"));
-    freeString(pathString);
+    // write next to the target and rename it over, a crash never leaves a half written file
+    char tmp[TICNAME_MAX + sizeof ".4294967295.tmp"];
+    const FsString* tmpString = NULL;
+    FILE* file = openTempFile(name, tmp, sizeof tmp, &tmpString);
+    bool done = false;
 
     if(file)
     {
-        fwrite(buffer, 1, size, file);
-        fclose(file);
+        done = fwrite(buffer, 1, size, file) == size
+            && fflush(file) == 0
+            && tic_fsync(file) == 0;
+
+        done = fclose(file) == 0 && done;
+
+        if(done)
+        {
+            const FsString* pathString = utf8ToString(name);
+            done = tic_rename(tmpString, pathString);
+            freeString(pathString);
+        }
+
+        if(!done)
+            tic_remove(tmpString);
 
 #if defined(__EMSCRIPTEN__)
         syncfs();
 #endif
 
-        return true;
+        freeString(tmpString);
     }
 
-    return false;
+    return done;
 #endif
 }
 
+typedef struct WriteJob
+{
+    char path[TICNAME_MAX];
+    void* data;
+    s32 size;
+    fs_write_callback callback;
+    void* calldata;
+    struct WriteJob* next;
+} WriteJob;
+
+// write-behind queue served by a single thread, see fs_write_async()
+static struct
+{
+    tic_thread* thread;
+    tic_mutex* lock;
+    tic_cond* cond;
+    WriteJob* head;
+    WriteJob* active;
+    bool quit;
+} Writer;
+
+static s32 writerThread(void* data)
+{
+    tic_mutex_lock(Writer.lock);
+
+    for(;;)
+    {
+        while(!Writer.head && !Writer.quit)
+            tic_cond_wait(Writer.cond, Writer.lock);
+
+        if(!Writer.head)
+            break;
+
+        WriteJob* job = Writer.active = Writer.head;
+        Writer.head = job->next;
+        tic_mutex_unlock(Writer.lock);
+
+        bool done = fs_write(job->path, job->data, job->size);
+
+        if(job->callback)
+            job->callback(done, job->calldata);
+
+        tic_mutex_lock(Writer.lock);
+        Writer.active = NULL;
+        tic_cond_broadcast(Writer.cond);
+
+        free(job->data);
+        free(job);
+    }
+
+    tic_mutex_unlock(Writer.lock);
+
+    return 0;
+}
+
+static bool startWriter()
+{
+    if(Writer.thread)
+        return true;
+
+    Writer.lock = tic_mutex_create();
+    Writer.cond = tic_cond_create();
+    Writer.quit = false;
+
+    if(Writer.lock && Writer.cond && (Writer.thread = tic_thread_create(writerThread, NULL)))
+        return true;
+
+    if(Writer.lock) tic_mutex_free(Writer.lock);
+    if(Writer.cond) tic_cond_free(Writer.cond);
+    Writer.lock = NULL;
+    Writer.cond = NULL;
+
+    return false;
+}
+
+static bool writePending(const char* path)
+{
+    if(Writer.active && strcmp(Writer.active->path, path) == 0)
+        return true;
+
+    for(const WriteJob* job = Writer.head; job; job = job->next)
+        if(strcmp(job->path, path) == 0)
+            return true;
+
+    return false;
+}
+
+// readers must see the data of queued writes
+static void waitWrite(const char* path)
+{
+    if(Writer.thread)
+    {
+        tic_mutex_lock(Writer.lock);
+
+        while(writePending(path))
+            tic_cond_wait(Writer.cond, Writer.lock);
+
+        tic_mutex_unlock(Writer.lock);
+    }
+}
+
+void fs_write_async(const char* path, const void* data, s32 size, fs_write_callback callback, void* calldata)
+{
+    void* copy = malloc(size ? size : 1);
+    WriteJob* job = malloc(sizeof(WriteJob));
+
+    if(!copy || !job || strlen(path) >= TICNAME_MAX || !startWriter())
+    {
+        free(copy);
+        free(job);
+
+        bool done = fs_write(path, data, size);
+
+        if(callback)
+            callback(done, calldata);
+
+        return;
+    }
+
+    memcpy(copy, data, size);
+
+    tic_mutex_lock(Writer.lock);
+
+    WriteJob** tail = &Writer.head;
+    WriteJob* last = NULL;
+
+    for(; *tail; tail = &(*tail)->next)
+        if(strcmp((*tail)->path, path) == 0)
+            last = *tail;
+
+    // the newest save that hasn't started yet just takes the newer data
+    if(last && last->callback == callback && last->calldata == calldata)
+    {
+        free(last->data);
+        last->data = copy;
+        last->size = size;
+        free(job);
+    }
+    else
+    {
+        *job = (WriteJob){.data = copy, .size = size, .callback = callback, .calldata = calldata};
+        strcpy(job->path, path);
+        *tail = job;
+    }
+
+    tic_cond_broadcast(Writer.cond);
+    tic_mutex_unlock(Writer.lock);
+}
+
+void fs_write_flush()
+{
+    if(Writer.thread)
+    {
+        tic_mutex_lock(Writer.lock);
+        Writer.quit = true;
+        tic_cond_broadcast(Writer.cond);
+        tic_mutex_unlock(Writer.lock);
+
+        tic_thread_join(Writer.thread);
+        tic_mutex_free(Writer.lock);
+        tic_cond_free(Writer.cond);
+
+        Writer.thread = NULL;
+        Writer.lock = NULL;
+        Writer.cond = NULL;
+    }
+}
+
 void* fs_read(const char* path, s32* size)
 {
+    waitWrite(path);
+
 #if defined(BAREMETALPI)
     dbg("fs_read %s\n", path);
     FILINFO fi;
@@ -686,6 +920,204 @@ void* fs_read(const char* path, s32* size)
 #endif
 }
 
+struct fs_file
+{
+#if defined(BAREMETALPI)
+    FIL file;
+#else
+    FILE* file;
+
+    // set by fs_replace(), the temp file is renamed over the target on close
+    char* temp;
+    char* target;
+#endif
+    bool error;
+};
+
+bool fs_map(const char* path, fs_mapping* map)
+{
+    waitWrite(path);
+
+#if defined(USE_MMAP)
+    s32 fd = open(path, O_RDONLY);
+
+    if(fd >= 0)
+    {
+        struct stat st;
+        void* data = MAP_FAILED;
+
+        // empty files can't be mapped, they go through fs_read() below
+        if(fstat(fd, &st) == 0 && st.st_size > 0 && st.st_size <= INT32_MAX)
+            data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        close(fd);
+
+        if(data != MAP_FAILED)
+        {
+            *map = (fs_mapping){data, (s32)st.st_size, true};
+            return true;
+        }
+    }
+#endif
+
+    s32 size = 0;
+    void* data = fs_read(path, &size);
+
+    *map = (fs_mapping){data, size, false};
+    return data != NULL;
+}
+
+void fs_unmap(fs_mapping* map)
+{
+#if defined(USE_MMAP)
+    if(map->mapped)
+        munmap((void*)map->data, map->size);
+    else
+#endif
+        free((void*)map->data);
+
+    *map = (fs_mapping){0};
+}
+
+fs_file* fs_create(const char* path)
+{
+    fs_file* file = calloc(1, sizeof(fs_file));
+
+#if defined(BAREMETALPI)
+    dbg("fs_create %s\n", path);
+    if(f_open(&file->file, path, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK)
+    {
+        free(file);
+        return NULL;
+    }
+#else
+    const FsString* pathString = utf8ToString(path);
+    file->file = tic_fopen(pathString, _S("wb"));
+    freeString(pathString);
+
+    if(!file->file)
+    {
+        free(file);
+        return NULL;
+    }
+#endif
+
+    return file;
+}
+
+fs_file* fs_replace(const char* path)
+{
+#if defined(BAREMETALPI)
+    return fs_create(path);
+#else
+    // a queued write of the same file must not land over the new one
+    waitWrite(path);
+
+    char tmp[TICNAME_MAX + sizeof ".4294967295.tmp"];
+    const FsString* tmpString = NULL;
+    FILE* handle = openTempFile(path, tmp, sizeof tmp, &tmpString);
+
+    if(!handle)
+        return NULL;
+
+    freeString(tmpString);
+
+    fs_file* file = calloc(1, sizeof(fs_file));
+    file->file = handle;
+    file->temp = strdup(tmp);
+    file->target = strdup(path);
+
+    return file;
+#endif
+}
+
+fs_file* fs_stdout()
+{
+#if defined(BAREMETALPI)
+    return NULL;
+#else
+    fs_file* file = calloc(1, sizeof(fs_file));
+
+    // the stream takes over the real stdout, text output goes to stderr
+    fflush(stdout);
+    s32 fd = dup(fileno(stdout));
+
+    if(fd < 0 || dup2(fileno(stderr), fileno(stdout)) < 0)
+    {
+        free(file);
+        return NULL;
+    }
+
+#if defined(__TIC_WINDOWS__)
+    _setmode(fd, _O_BINARY);
+#endif
+
+    if(!(file->file = fdopen(fd, "wb")))
+    {
+        free(file);
+        return NULL;
+    }
+
+    return file;
+#endif
+}
+
+bool fs_append(fs_file* file, const void* buffer, s32 size)
+{
+#if defined(BAREMETALPI)
+    UINT written = 0;
+    if(f_write(&file->file, buffer, size, &written) != FR_OK || written != size)
+        file->error = true;
+#else
+    if(fwrite(buffer, 1, size, file->file) != size)
+        file->error = true;
+#endif
+
+    return !file->error;
+}
+
+bool fs_close(fs_file* file)
+{
+#if defined(BAREMETALPI)
+    if(f_close(&file->file) != FR_OK)
+        file->error = true;
+#else
+    if(file->target && !file->error && (fflush(file->file) != 0 || tic_fsync(file->file) != 0))
+        file->error = true;
+
+    if(fclose(file->file) != 0)
+        file->error = true;
+
+    if(file->target)
+    {
+        const FsString* tempString = utf8ToString(file->temp);
+
+        if(!file->error)
+        {
+            const FsString* targetString = utf8ToString(file->target);
+            file->error = !tic_rename(tempString, targetString);
+            freeString(targetString);
+        }
+
+        if(file->error)
+            tic_remove(tempString);
+
+        freeString(tempString);
+        free(file->temp);
+        free(file->target);
+    }
+
+#if defined(__EMSCRIPTEN__)
+    syncfs();
+#endif
+
+#endif
+
+    bool done = !file->error;
+    free(file);
+    return done;
+}
+
 bool fs_exists(const char* name)
 {
 #if defined(BAREMETALPI)
@@ -732,6 +1164,134 @@ u64 fs_date(const char* path)
 #endif
 }
 
+struct fs_watch
+{
+    char path[TICNAME_MAX];
+    u64 date;
+
+    // polled even with inotify, which reports nothing for changes
+    // made by other machines on network mounts (NFS, SMB)
+    s32 interval;
+    u64 next;
+
+#if defined(USE_INOTIFY)
+    // the parent folder is watched, editors often save by renaming a temp file over the original
+    s32 fd;
+    s32 wd;
+    const char* name;
+#endif
+};
+
+fs_watch* fs_watch_create()
+{
+    fs_watch* watch = calloc(1, sizeof(fs_watch));
+
+#if defined(USE_INOTIFY)
+    watch->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    watch->wd = -1;
+#endif
+
+    return watch;
+}
+
+void fs_watch_file(fs_watch* watch, const char* path, s32 interval)
+{
+    watch->interval = interval;
+    watch->next = 0;
+
+    if(strcmp(watch->path, path) != 0)
+    {
+        snprintf(watch->path, sizeof watch->path, "%s", path);
+
+#if defined(USE_INOTIFY)
+        if(watch->wd >= 0)
+        {
+            inotify_rm_watch(watch->fd, watch->wd);
+            watch->wd = -1;
+        }
+
+        const char* slash = strrchr(watch->path, SLASH_SYMBOL);
+
+        if(watch->fd >= 0 && *path)
+        {
+            char dir[TICNAME_MAX];
+            snprintf(dir, sizeof dir, "%.*s", slash ? (s32)(slash - watch->path) : 1, slash ? watch->path : ".");
+
+            watch->wd = inotify_add_watch(watch->fd, *dir ? dir : "/", IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ATTRIB);
+            watch->name = slash ? slash + 1 : watch->path;
+        }
+#endif
+    }
+
+    watch->date = *path ? fs_date(path) : 0;
+}
+
+#if defined(USE_INOTIFY)
+static bool readWatchEvents(fs_watch* watch)
+{
+    bool found = false;
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    for(ssize_t size; (size = read(watch->fd, buffer, sizeof buffer)) > 0;)
+    {
+        for(const char* ptr = buffer; ptr < buffer + size;)
+        {
+            const struct inotify_event* event = (const struct inotify_event*)ptr;
+
+            if(event->wd == watch->wd && event->len && strcmp(event->name, watch->name) == 0)
+                found = true;
+
+            ptr += sizeof(struct inotify_event) + event->len;
+        }
+    }
+
+    return found;
+}
+#endif
+
+bool fs_watch_changed(fs_watch* watch)
+{
+    if(!*watch->path)
+        return false;
+
+    bool event = false;
+
+#if defined(USE_INOTIFY)
+    if(watch->wd >= 0)
+        event = readWatchEvents(watch);
+#endif
+
+    if(!event)
+    {
+        u64 now = tic_sys_counter_get() * 1000 / tic_sys_freq_get();
+
+        if(now < watch->next)
+            return false;
+
+        watch->next = now + watch->interval;
+    }
+
+    u64 date = fs_date(watch->path);
+
+    if(date != watch->date)
+    {
+        watch->date = date;
+        return true;
+    }
+
+    return false;
+}
+
+void fs_watch_free(fs_watch* watch)
+{
+#if defined(USE_INOTIFY)
+    if(watch->fd >= 0)
+        close(watch->fd);
+#endif
+
+    free(watch);
+}
+
 bool tic_fs_save(tic_fs* fs, const char* name, const void* data, s32 size, bool overwrite)
 {
     if(!overwrite)
@@ -875,7 +1435,10 @@ void* tic_fs_load(tic_fs* fs, const char* name, s32* size)
     return NULL;
 #else
 
-    const FsString* pathString = utf8ToString(tic_fs_path(fs, name));
+    const char* path = tic_fs_path(fs, name);
+    waitWrite(path);
+
+    const FsString* pathString = utf8ToString(path);
     FILE* file = tic_fopen(pathString, _S("rb"));
     freeString(pathString);
 
@@ -904,6 +1467,20 @@ void* tic_fs_loadroot(tic_fs* fs, const char* name, s32* size)
     return fs_read(tic_fs_pathroot(fs, name), size);
 }
 
+bool tic_fs_map(tic_fs* fs, const char* name, fs_mapping* map)
+{
+    // both paths wait for the queued writes of the file
+#if defined(USE_MMAP)
+    return fs_map(tic_fs_path(fs, name), map);
+#else
+    s32 size = 0;
+    void* data = tic_fs_load(fs, name, &size);
+
+    *map = (fs_mapping){data, size, false};
+    return data != NULL;
+#endif
+}
+
 bool tic_fs_makedir(tic_fs* fs, const char* name)
 {
 #if defined(BAREMETALPI)
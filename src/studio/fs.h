@@ -29,8 +29,19 @@ typedef bool(*fs_list_callback)(const char* name, const char* title, const char*
 typedef void(*fs_done_callback)(void* data);
 typedef void(*fs_isdir_callback)(bool dir, void* data);
 typedef void(*fs_load_callback)(const u8* buffer, s32 size, void* data);
+typedef void(*fs_write_callback)(bool done, void* data);
+
+// file contents, memory mapped where the platform allows it, release with fs_unmap()
+typedef struct
+{
+    const u8* data;
+    s32 size;
+    bool mapped;
+} fs_mapping;
 
 typedef struct tic_fs tic_fs;
+typedef struct fs_file fs_file;
+typedef struct fs_watch fs_watch;
 struct tic_net;
 
 tic_fs*     tic_fs_create   (const char* path, struct tic_net* net);
@@ -46,6 +57,7 @@ bool    tic_fs_save         (tic_fs* fs, const char* name, const void* data, s32
 bool    tic_fs_saveroot     (tic_fs* fs, const char* name, const void* data, s32 size, bool overwrite);
 void*   tic_fs_load         (tic_fs* fs, const char* name, s32* size);
 void*   tic_fs_loadroot     (tic_fs* fs, const char* name, s32* size);
+bool    tic_fs_map          (tic_fs* fs, const char* name, fs_mapping* map);
 bool    tic_fs_makedir      (tic_fs* fs, const char* name);
 bool    tic_fs_exists       (tic_fs* fs, const char* name);
 void    tic_fs_openfolder   (tic_fs* fs);
@@ -62,6 +74,27 @@ bool    fs_exists   (const char* name);
 bool    fs_isdir    (const char* path);
 void*   fs_read     (const char* path, s32* size);
 bool    fs_write    (const char* path, const void* data, s32 size);
+bool    fs_map      (const char* path, fs_mapping* map);
+void    fs_unmap    (fs_mapping* map);
+fs_file* fs_create  (const char* path);
+// writes to a temp file next to `path`, fs_close() renames it over `path`
+// only if every write succeeded, so a failed save keeps the old file
+fs_file* fs_replace (const char* path);
+fs_file* fs_stdout  ();
+bool    fs_append   (fs_file* file, const void* data, s32 size);
+bool    fs_close    (fs_file* file);
+
+// queues the write for a background thread, a pending write to the same path
+// with the same callback takes the newer data; `callback` runs on that thread
+void    fs_write_async  (const char* path, const void* data, s32 size, fs_write_callback callback, void* calldata);
+// waits for all queued writes and stops the writer thread
+void    fs_write_flush  ();
+
+// file change notifications: inotify on Linux, polling every `interval` ms elsewhere
+fs_watch* fs_watch_create   ();
+void    fs_watch_file       (fs_watch* watch, const char* path, s32 interval);
+bool    fs_watch_changed    (fs_watch* watch);
+void    fs_watch_free       (fs_watch* watch);
 void    fs_enum     (const char* path, fs_list_callback callback, void* data);
 
 const char* fs_apppath();
@@ -28,6 +28,7 @@
 #include <string.h>
 #include <ctype.h>
 #include <stddef.h>
+#include <stdarg.h>
 
 static const struct BinarySection{const char* tag; s32 count; s32 offset; s32 size; bool flip;} BinarySections[] =
 {
@@ -60,49 +61,102 @@ static bool bufferEmpty(const u8* data, s32 size)
     return true;
 }
 
-static char* saveTextSection(char* ptr, const char* data)
+enum{WriterBufferSize = 16 * 1024};
+
+typedef struct
 {
-    if(data[0] == '\0')
-        return ptr;
+    tic_project_write_callback write;
+    void* data;
+    s32 size;
+    bool error;
+    char buffer[WriterBufferSize];
+} ProjectWriter;
+
+static void flushWriter(ProjectWriter* writer)
+{
+    if(writer->size && !writer->error)
+        writer->error = !writer->write(writer->buffer, writer->size, writer->data);
 
-    sprintf(ptr, "%s\n", data);
-    ptr += strlen(ptr);
+    writer->size = 0;
+}
 
-    return ptr;
+// returns room for at least `size` chars, `size` must fit the buffer
+static char* reserveWriter(ProjectWriter* writer, s32 size)
+{
+    if(writer->size + size > sizeof writer->buffer)
+        flushWriter(writer);
+
+    return writer->buffer + writer->size;
 }
 
-static char* saveBinaryBuffer(char* ptr, const char* comment, const void* data, s32 size, s32 row, bool flip)
+static void writeString(ProjectWriter* writer, const char* str, s32 size)
 {
-    if(bufferEmpty(data, size))
-        return ptr;
+    if(size > sizeof writer->buffer)
+    {
+        flushWriter(writer);
 
-    sprintf(ptr, "%s %03i:", comment, row);
-    ptr += strlen(ptr);
+        if(!writer->error)
+            writer->error = !writer->write(str, size, writer->data);
+    }
+    else
+    {
+        memcpy(reserveWriter(writer, size), str, size);
+        writer->size += size;
+    }
+}
 
-    tic_tool_buf2str(data, size, ptr, flip);
-    ptr += strlen(ptr);
+static void writeFormat(ProjectWriter* writer, const char* format, ...)
+{
+    enum{MaxSize = 256};
+    char* ptr = reserveWriter(writer, MaxSize);
 
-    sprintf(ptr, "\n");
-    ptr += strlen(ptr);
+    va_list args;
+    va_start(args, format);
+    s32 size = vsnprintf(ptr, MaxSize, format, args);
+    va_end(args);
 
-    return ptr;
+    writer->size += MIN(size, MaxSize - 1);
+}
+
+static void saveTextSection(ProjectWriter* writer, const char* data)
+{
+    if(data[0] == '\0')
+        return;
+
+    writeString(writer, data, (s32)strlen(data));
+    writeString(writer, "\n", 1);
 }
 
-static char* saveBinarySection(char* ptr, const char* comment, const char* tag, s32 count, const void* data, s32 size, bool flip)
+static void saveBinaryBuffer(ProjectWriter* writer, const char* comment, const void* data, s32 size, s32 row, bool flip)
+{
+    if(bufferEmpty(data, size))
+        return;
+
+    writeFormat(writer, "%s %03i:", comment, row);
+
+    // hex goes straight into the output buffer, in pieces for rows that don't fit
+    enum{Chunk = WriterBufferSize / 4};
+    for(s32 i = 0; i < size; i += Chunk)
+    {
+        s32 count = MIN(size - i, Chunk);
+        tic_tool_buf2str((const u8*)data + i, count, reserveWriter(writer, count * 2 + 1), flip);
+        writer->size += count * 2;
+    }
+
+    writeString(writer, "\n", 1);
+}
+
+static void saveBinarySection(ProjectWriter* writer, const char* comment, const char* tag, s32 count, const void* data, s32 size, bool flip)
 {
     if(bufferEmpty(data, size * count))
-        return ptr;
+        return;
 
-    sprintf(ptr, "%s <%s>\n", comment, tag);
-    ptr += strlen(ptr);
+    writeFormat(writer, "%s <%s>\n", comment, tag);
 
     for(s32 i = 0; i < count; i++, data = (u8*)data + size)
-        ptr = saveBinaryBuffer(ptr, comment, data, size, i, flip);
+        saveBinaryBuffer(writer, comment, data, size, i, flip);
 
-    sprintf(ptr, "%s </%s>\n\n", comment, tag);
-    ptr += strlen(ptr);
-
-    return ptr;
+    writeFormat(writer, "%s </%s>\n\n", comment, tag);
 }
 
 static const char* projectComment(const char* name)
@@ -116,84 +170,142 @@ static const char* projectComment(const char* name)
     return NULL;
 }
 
-s32 tic_project_save(const char* name, void* data, const tic_cartridge* cart)
+bool tic_project_write(const char* name, const tic_cartridge* cart, tic_project_write_callback write, void* data)
 {
     const char* comment = projectComment(name);
-    char* stream = data;
-    char* ptr = saveTextSection(stream, cart->code.data);
     char tag[16];
 
+    ProjectWriter* writer = malloc(sizeof(ProjectWriter));
+
+    if(!writer)
+        return false;
+
+    *writer = (ProjectWriter){write, data};
+
+    saveTextSection(writer, cart->code.data);
+
     FOR(const struct BinarySection*, section, BinarySections)
         for(s32 b = 0; b < TIC_BANKS; b++)
         {
             makeTag(section->tag, tag, b);
 
-            ptr = saveBinarySection(ptr, comment, tag, section->count,
+            saveBinarySection(writer, comment, tag, section->count,
                 (u8*)&cart->banks[b] + section->offset, section->size, section->flip);
         }
 
     if(cart->lang)
-        ptr = saveBinarySection(ptr, comment, LangSection.tag, LangSection.count, &cart->lang, LangSection.size, LangSection.flip);
+        saveBinarySection(writer, comment, LangSection.tag, LangSection.count, &cart->lang, LangSection.size, LangSection.flip);
 
-    return (s32)strlen(stream);
+    flushWriter(writer);
+
+    bool done = !writer->error;
+    free(writer);
+
+    return done;
 }
 
-static bool loadTextSection(const char* project, const char* comment, char* dst, s32 size)
+typedef struct
 {
-    bool done = false;
+    char* ptr;
+    s32 size;
+} ProjectBuffer;
 
+static bool writeBuffer(const void* buffer, s32 size, void* data)
+{
+    ProjectBuffer* dst = data;
+    memcpy(dst->ptr + dst->size, buffer, size);
+    dst->size += size;
+
+    return true;
+}
+
+s32 tic_project_save(const char* name, void* data, const tic_cartridge* cart)
+{
+    ProjectBuffer buffer = {data};
+
+    if(!tic_project_write(name, cart, writeBuffer, &buffer))
+        return 0;
+
+    buffer.ptr[buffer.size] = '\0';
+
+    return buffer.size;
+}
+
+// strstr() for text that isn't null terminated
+static const char* findText(const char* start, const char* end, const char* str)
+{
+    const s32 len = (s32)strlen(str);
+
+    for(const char* ptr = start; end - ptr >= len; ptr++)
+    {
+        if(!(ptr = memchr(ptr, *str, end - ptr - len + 1)))
+            break;
+
+        if(memcmp(ptr, str, len) == 0)
+            return ptr;
+    }
+
+    return NULL;
+}
+
+static bool loadTextSection(const char* project, const char* end, const char* comment, char* dst, s32 size)
+{
     const char* start = project;
-    const char* end = project + strlen(project);
 
     {
         char tagstart[16];
         sprintf(tagstart, "\n%s <", comment);
 
-        const char* ptr = strstr(project, tagstart);
+        const char* ptr = findText(project, end, tagstart);
 
-        if(ptr && ptr < end)
+        if(ptr)
             end = ptr;
     }
 
     if(end > start)
     {
-        memcpy(dst, start, MIN(size, end - start));
-        done = true;
+        // drop '\r' chars on the way
+        for(const char* ptr = start; ptr < end && size; ptr++)
+            if(*ptr != '\r')
+                *dst++ = *ptr, size--;
+
+        return true;
     }
 
-    return done;
+    return false;
 }
 
-static inline const char* getLineEnd(const char* ptr)
+static inline const char* getLineEnd(const char* ptr, const char* end)
 {
-    while(*ptr && isspace(*ptr) && *ptr++ != '\n');
+    while(ptr < end && isspace(*ptr) && *ptr++ != '\n');
 
     return ptr;
 }
 
-static bool loadBinarySection(const char* project, const char* comment, const char* tag, s32 count, void* dst, s32 size, bool flip)
+static bool loadBinarySection(const char* project, const char* last, const char* comment, const char* tag, s32 count, void* dst, s32 size, bool flip)
 {
     char tagbuf[64];
     sprintf(tagbuf, "%s <%s>", comment, tag);
 
-    const char* start = strstr(project, tagbuf);
+    const char* start = findText(project, last, tagbuf);
     bool done = false;
 
     if(start)
     {
         start += strlen(tagbuf);
-        start = getLineEnd(start);
+        start = getLineEnd(start, last);
 
         sprintf(tagbuf, "\n%s </%s>", comment, tag);
-        const char* end = strstr(start, tagbuf);
+        const char* end = findText(start, last, tagbuf);
 
         if(end > start)
         {
             const char* ptr = start;
+            const s32 prefix = (s32)strlen(comment) + sizeof(" 999:") - 1;
 
             if(size > 0)
             {
-                while(ptr < end)
+                while(end - ptr > prefix)
                 {
                     static char lineStr[] = "999";
                     memcpy(lineStr, ptr + strlen(comment) + 1, sizeof lineStr - 1);
@@ -202,18 +314,19 @@ static bool loadBinarySection(const char* project, const char* comment, const ch
 
                     if(index < count)
                     {
-                        ptr += strlen(comment) + sizeof(" 999:") - 1;
-                        tic_tool_str2buf(ptr, size*2, (u8*)dst + size*index, flip);
+                        ptr += prefix;
+                        tic_tool_str2buf(ptr, MIN(size*2, (s32)(end - ptr)), (u8*)dst + size*index, flip);
                         ptr += size*2 + 1;
 
-                        ptr = getLineEnd(ptr);
+                        // a '\r' is skipped above, the '\n' here
+                        ptr = getLineEnd(MIN(ptr, end), end);
                     }
                     else break;
                 }
             }
-            else
+            else if(end - ptr > prefix)
             {
-                ptr += strlen(comment) + sizeof(" 999:") - 1;
+                ptr += prefix;
                 tic_tool_str2buf(ptr, (s32)(end - ptr), (u8*)dst, flip);
             }
 
@@ -226,50 +339,40 @@ static bool loadBinarySection(const char* project, const char* comment, const ch
 
 bool tic_project_load(const char* name, const char* data, s32 size, tic_cartridge* dst)
 {
-    char* project = (char*)malloc(size+1);
+    // the project is parsed in place, it can be a read-only mapping of the file
+    const char* end = memchr(data, '\0', size);
+
+    if(!end)
+        end = data + size;
 
     bool done = false;
 
-    if(project)
-    {
-        memcpy(project, data, size);
-        project[size] = '\0';
+    tic_cartridge* cart = calloc(1, sizeof(tic_cartridge));
 
-        // remove all the '\r' chars
-        {
-            char *s, *d;
-            for(s = d = project; (*d = *s); d += (*s++ != '\r'));
-        }
+    if(cart)
+    {
+        const char* comment = projectComment(name);
+        char tag[16];
 
-        tic_cartridge* cart = calloc(1, sizeof(tic_cartridge));
+        if(loadTextSection(data, end, comment, cart->code.data, sizeof(tic_code)))
+            done = true;
 
-        if(cart)
+        if(done)
         {
-            const char* comment = projectComment(name);
-            char tag[16];
-
-            if(loadTextSection(project, comment, cart->code.data, sizeof(tic_code)))
-                done = true;
-
-            if(done)
-            {
-                FOR(const struct BinarySection*, section, BinarySections)
-                    for(s32 b = 0; b < TIC_BANKS; b++)
-                    {
-                        makeTag(section->tag, tag, b);
-                        loadBinarySection(project, comment, tag, section->count, (u8*)&cart->banks[b] + section->offset, section->size, section->flip);
-                    }
-
-                loadBinarySection(project, comment, LangSection.tag, LangSection.count, &cart->lang, LangSection.size, LangSection.flip);
-            }
-
-            if(done)
-                memcpy(dst, cart, sizeof(tic_cartridge));
+            FOR(const struct BinarySection*, section, BinarySections)
+                for(s32 b = 0; b < TIC_BANKS; b++)
+                {
+                    makeTag(section->tag, tag, b);
+                    loadBinarySection(data, end, comment, tag, section->count, (u8*)&cart->banks[b] + section->offset, section->size, section->flip);
+                }
 
-            free(cart);
+            loadBinarySection(data, end, comment, LangSection.tag, LangSection.count, &cart->lang, LangSection.size, LangSection.flip);
         }
 
-        free(project);
+        if(done)
+            memcpy(dst, cart, sizeof(tic_cartridge));
+
+        free(cart);
     }
 
     return done;
@@ -24,5 +24,10 @@
 
 #include "cart.h"
 
+typedef bool(*tic_project_write_callback)(const void* buffer, s32 size, void* data);
+
 bool tic_project_load(const char* name, const char* data, s32 size, tic_cartridge* dst);
 s32 tic_project_save(const char* name, void* data, const tic_cartridge* cart);
+
+// streams the project text through `write` in buffer sized pieces
+bool tic_project_write(const char* name, const tic_cartridge* cart, tic_project_write_callback write, void* data);
@@ -27,7 +27,10 @@
 #include "studio/net.h"
 #include "studio/config.h"
 #include "ext/png.h"
+#include "ext/thread.h"
 #include "ext/json.h"
+#include "ext/fft.h"
+#include "fftdata.h"
 #include "zip.h"
 #include "retro_endianness.h"
 
@@ -96,7 +99,9 @@
     macro(w)                    \
     macro(h)                    \
     macro(vbank)                \
-    macro(bpp)
+    macro(bpp)                  \
+    macro(dither)               \
+    macro(frames)
 
 #define EXPORT_CMD_LIST(macro)  \
     macro(win)                  \
@@ -125,6 +130,7 @@
     macro(bank)                 \
     macro(vbank)                \
     macro(id)                   \
+    macro(stems)                \
     ALONE_KEY(macro)
 
 static const char* WelcomeText =
@@ -193,6 +199,7 @@ static const struct HotkeysRowCodeEditor {const char* section; const char* info;
     {"F1",                 "Move to next bookmark."},
     {"CTRL+B",             "Show bookmark list."},
     {"CTRL+O",             "Show code outline and navigate functions."},
+    {"CTRL+U",             "Show lines using the word under the cursor."},
     {"CTRL+TAB",           "Indent line."},
     {"CTRL+SHIFT+TAB",     "Unindent line."},
     {"CTRL+/",             "Comment/Uncomment line."},
@@ -1012,30 +1019,27 @@ static void onLoadCommandConfirmed(Console* console)
         }
         else
         {
-            s32 size = 0;
-            void* data = strcmp(name, CONFIG_TIC_PATH) == 0
-                ? tic_fs_loadroot(console->fs, name, &size)
-                : tic_fs_load(console->fs, name, &size);
+            fs_mapping file;
+            bool loaded = strcmp(name, CONFIG_TIC_PATH) == 0
+                ? fs_map(tic_fs_pathroot(console->fs, name), &file)
+                : tic_fs_map(console->fs, name, &file);
 
-            if(data) SCOPE(free(data))
+            if(loaded) SCOPE(fs_unmap(&file))
             {
                 tic_cartridge* cart = newCart();
 
                 SCOPE(free(cart))
                 {
-                    tic_cart_load(cart, data, size);
+                    tic_cart_load(cart, file.data, file.size);
                     loadCartSection(console, cart, section);
                     onCartLoaded(console, name, section);
                 }
             }
-            else if(tic_tool_has_ext(param, PngExt) && tic_fs_exists(console->fs, param))
+            else if(tic_tool_has_ext(param, PngExt) && tic_fs_map(console->fs, param, &file))
             {
-                png_buffer buffer;
-                buffer.data = tic_fs_load(console->fs, param, &buffer.size);
-
-                SCOPE(free(buffer.data))
+                SCOPE(fs_unmap(&file))
                 {
-                    tic_cartridge* cart = loadPngCart(buffer);
+                    tic_cartridge* cart = loadPngCart((png_buffer){(u8*)file.data, file.size});
 
                     if(cart) SCOPE(free(cart))
                     {
@@ -1052,15 +1056,15 @@ static void onLoadCommandConfirmed(Console* console)
 #if defined(TIC80_PRO)
                 if(project_ext(name))
                 {
-                    void* data = tic_fs_load(console->fs, name, &size);
+                    fs_mapping file;
 
-                    if(data) SCOPE(free(data))
+                    if(tic_fs_map(console->fs, name, &file)) SCOPE(fs_unmap(&file))
                     {
                         tic_cartridge* cart = newCart();
 
                         SCOPE(free(cart))
                         {
-                            tic_project_load(name, data, size, cart);
+                            tic_project_load(name, (const char*)file.data, file.size, cart);
                             loadCartSection(console, cart, section);
                             onCartLoaded(console, name, section);
                         }
@@ -1697,6 +1701,22 @@ static void onInstallDemosCommand(Console* console)
     commandDone(console);
 }
 
+static void onFftCommand(Console* console)
+{
+    if(fftEnabled)
+    {
+        uint32_t overruns, underruns;
+        FFT_GetStats(&overruns, &underruns);
+
+        char buf[TICNAME_MAX];
+        snprintf(buf, sizeof buf, "\nfft overruns: %u underruns: %u", overruns, underruns);
+        printBack(console, buf);
+    }
+    else printError(console, "\nFFT is not enabled, run with --fft");
+
+    commandDone(console);
+}
+
 static void onGameMenuCommand(Console* console)
 {
     gotoMenu(console->studio);
@@ -1808,7 +1828,165 @@ static inline const tic_palette* getPalette(Console* console, s32 bank, s32 vban
         : &getBank(console, bank)->palette.vbank0;
 }
 
-static void onImportTilesBase(Console* console, const char* name, const void* buffer, s32 size, tic_tile* base, ImportParams params)
+enum
+{
+    DitherNone,
+    DitherOrdered,
+    DitherDiffusion,
+};
+
+typedef struct
+{
+    png_img img;
+    const tic_rgb* palette;
+    s32 count;
+    bool ordered;
+    u8* colors;
+} QuantizeJob;
+
+enum {QuantizeBand = 16};
+
+static inline u8 clampColor(s32 value)
+{
+    return value < 0 ? 0 : value > UINT8_MAX ? UINT8_MAX : value;
+}
+
+static void quantizeBand(s32 index, void* data)
+{
+    static const s8 Bayer[4][4] =
+    {
+        { 0,  8,  2, 10},
+        {12,  4, 14,  6},
+        { 3, 11,  1,  9},
+        {15,  7, 13,  5},
+    };
+
+    const QuantizeJob* job = data;
+    const png_img* img = &job->img;
+
+    tic_color_cache cache;
+    tic_color_cache_init(&cache, job->palette, job->count);
+
+    for(s32 y = index * QuantizeBand, end = MIN(y + QuantizeBand, img->height); y < end; y++)
+        for(s32 x = 0; x < img->width; x++)
+        {
+            const png_rgba* pix = img->pixels + x + y * img->width;
+            tic_rgb rgb = {pix->r, pix->g, pix->b};
+
+            if(job->ordered)
+            {
+                s32 offset = (Bayer[y & 3][x & 3] * 2 - 15) * 2;
+                rgb = (tic_rgb){clampColor(rgb.r + offset), clampColor(rgb.g + offset), clampColor(rgb.b + offset)};
+            }
+
+            job->colors[x + y * img->width] = tic_color_cache_nearest(&cache, &rgb);
+        }
+}
+
+// Floyd-Steinberg, every row depends on the previous one so it runs on a single thread
+static bool quantizeDiffusion(const QuantizeJob* job)
+{
+    const png_img* img = &job->img;
+    s32 width = img->width;
+
+    // errors of the current and the next row, one pixel of padding on both sides
+    s32* errors = calloc((width + 2) * 2 * 3, sizeof(s32));
+
+    if(!errors)
+        return false;
+
+    tic_color_cache cache;
+    tic_color_cache_init(&cache, job->palette, job->count);
+
+    for(s32 y = 0; y < img->height; y++)
+    {
+        s32* cur = errors + ((y & 1) ? (width + 2) * 3 : 0);
+        s32* next = errors + ((y & 1) ? 0 : (width + 2) * 3);
+        memset(next, 0, (width + 2) * 3 * sizeof(s32));
+
+        for(s32 x = 0; x < width; x++)
+        {
+            const png_rgba* pix = img->pixels + x + y * width;
+            const s32* err = cur + (x + 1) * 3;
+
+            tic_rgb rgb =
+            {
+                clampColor(pix->r + err[0] / 16),
+                clampColor(pix->g + err[1] / 16),
+                clampColor(pix->b + err[2] / 16),
+            };
+
+            u8 color = job->colors[x + y * width] = tic_color_cache_nearest(&cache, &rgb);
+            const tic_rgb* nearest = job->palette + color;
+
+            s32 diff[] = {rgb.r - nearest->r, rgb.g - nearest->g, rgb.b - nearest->b};
+
+            for(s32 c = 0; c < COUNT_OF(diff); c++)
+            {
+                cur[(x + 2) * 3 + c] += diff[c] * 7;
+                next[x * 3 + c] += diff[c] * 3;
+                next[(x + 1) * 3 + c] += diff[c] * 5;
+                next[(x + 2) * 3 + c] += diff[c];
+            }
+        }
+    }
+
+    free(errors);
+
+    return true;
+}
+
+// maps every pixel of the image to the nearest of the first `count` palette colors
+static u8* quantizeImage(png_img img, const tic_rgb* palette, s32 count, s32 dither)
+{
+    u8* colors = malloc(img.width * img.height);
+
+    if(!colors)
+        return NULL;
+
+    QuantizeJob job = {img, palette, count, dither == DitherOrdered, colors};
+
+    if(dither == DitherDiffusion)
+    {
+        if(!quantizeDiffusion(&job))
+        {
+            free(colors);
+            return NULL;
+        }
+    }
+    else
+    {
+        enum {ParallelSize = 256 * 256};
+
+        s32 bands = (img.height + QuantizeBand - 1) / QuantizeBand;
+        tic_pool* pool = img.width * img.height >= ParallelSize
+            ? tic_pool_create(tic_thread_count() - 1)
+            : NULL;
+
+        if(pool)
+        {
+            tic_pool_run(pool, bands, quantizeBand, &job);
+            tic_pool_free(pool);
+        }
+        else
+            for(s32 i = 0; i < bands; i++)
+                quantizeBand(i, &job);
+    }
+
+    return colors;
+}
+
+// the image can hold a vertical stack of `frames` equal frames, which are imported to the consecutive banks
+static inline s32 getImportFrames(png_img img, ImportParams params)
+{
+    s32 frames = MAX(params.frames, 1);
+
+    return params.bank + frames <= TIC_BANKS && img.height % frames == 0
+        ? frames
+        : 0;
+}
+
+static void onImportTilesBase(Console* console, const char* name, const void* buffer, s32 size, bool sprites, ImportParams params)
 {
     png_buffer png = {(u8*)buffer, size};
     bool error = true;
@@ -1827,48 +2005,56 @@ static void onImportTilesBase(Console* console, const char* name, const void* bu
 
     if(img.data) SCOPE(free(img.data))
     {
+        s32 frames = getImportFrames(img, params);
         const tic_palette* pal = getPalette(console, params.bank, params.vbank);
+        u8* colors = frames ? quantizeImage(img, pal->colors, 1 << bpp, params.dither) : NULL;
 
-        s32 bpp_scale = 1;
-        switch (bpp) {
-            case 1:
-                bpp_scale = 4;
-                break;
-            case 2:
-                bpp_scale = 2;
-                break;
-            default:
-                break;
-        }
-        u32 color1, color2, color3, color4, color;
-
-        for(s32 j = 0, y = params.y, h = y + (params.h ? params.h : img.height); y < h; ++y, ++j)
-            for(s32 i = 0, x = params.x, w = x + ((params.w ? params.w : img.width) / bpp_scale); x < w; ++x, i += bpp_scale)
-                if(x >= 0 && x < TIC_SPRITESHEET_SIZE && y >= 0 && y < TIC_SPRITESHEET_SIZE)
-                    switch (bpp) {
-                        case 4:
-                            setSpritePixel(base, x, y, tic_nearest_color(pal->colors,
-                               (tic_rgb*)(img.pixels + i + j * img.width), TIC_PALETTE_SIZE));
-                            break;
-                        case 2:
-                            color1 = tic_nearest_color(pal->colors, (tic_rgb*)(img.pixels + i + j * img.width), 4);
-                            color2 = tic_nearest_color(pal->colors, (tic_rgb*)(img.pixels + i + 1 + j * img.width), 4);
-                            // adding them together caused issues with squashing??? no idea why this isn't the case
-                            // for bpp 1
-                            color = (color2 << 2) | color1;
-                            setSpritePixel(base, x, y, color);
-                            break;
-                        case 1:
-                            color1 = tic_nearest_color(pal->colors, (tic_rgb*)(img.pixels + i + j * img.width), 2);
-                            color2 = tic_nearest_color(pal->colors, (tic_rgb*)(img.pixels + i + 1 + j * img.width), 2);
-                            color3 = tic_nearest_color(pal->colors, (tic_rgb*)(img.pixels + i + 2 + j * img.width), 2);
-                            color4 = tic_nearest_color(pal->colors, (tic_rgb*)(img.pixels + i + 3 + j * img.width), 2);
-                            color = (color4 << 3) | (color3 << 2) | (color2 << 1) | color1;
-                            setSpritePixel(base, x, y, color);
-                            break;
-                    }
+        if(colors) SCOPE(free(colors))
+        {
+            s32 bpp_scale = 1;
+            switch (bpp) {
+                case 1:
+                    bpp_scale = 4;
+                    break;
+                case 2:
+                    bpp_scale = 2;
+                    break;
+                default:
+                    break;
+            }
+
+            s32 frameHeight = img.height / frames;
+
+            for(s32 frame = 0; frame < frames; frame++)
+            {
+                tic_bank* bank = getBank(console, params.bank + frame);
+                tic_tile* base = sprites ? bank->sprites.data : bank->tiles.data;
+                const u8* frameColors = colors + frame * frameHeight * img.width;
+
+                for(s32 j = 0, y = params.y, h = y + (params.h ? MIN(params.h, frameHeight) : frameHeight); y < h; ++y, ++j)
+                    for(s32 i = 0, x = params.x, w = x + ((params.w ? MIN(params.w, img.width) : img.width) / bpp_scale); x < w; ++x, i += bpp_scale)
+                        if(x >= 0 && x < TIC_SPRITESHEET_SIZE && y >= 0 && y < TIC_SPRITESHEET_SIZE)
+                        {
+                            const u8* color = frameColors + i + j * img.width;
+
+                            switch (bpp) {
+                                case 4:
+                                    setSpritePixel(base, x, y, color[0]);
+                                    break;
+                                case 2:
+                                    // adding them together caused issues with squashing??? no idea why this isn't the case
+                                    // for bpp 1
+                                    setSpritePixel(base, x, y, (color[1] << 2) | color[0]);
+                                    break;
+                                case 1:
+                                    setSpritePixel(base, x, y, (color[3] << 3) | (color[2] << 2) | (color[1] << 1) | color[0]);
+                                    break;
+                            }
+                        }
+            }
 
-        error = false;
+            error = false;
+        }
     }
 
 exit:
@@ -1877,7 +2063,7 @@ exit:
 
 static void onImport_tiles(Console* console, const char* name, const void* buffer, s32 size, ImportParams params)
 {
-    onImportTilesBase(console, name, buffer, size, getBank(console, params.bank)->tiles.data, params);
+    onImportTilesBase(console, name, buffer, size, false, params);
 }
 
 static void onImport_binary(Console* console, const char* name, const void* buffer, s32 size, ImportParams params)
@@ -1896,7 +2082,7 @@ static void onImport_binary(Console* console, const char* name, const void* buff
 
 static void onImport_sprites(Console* console, const char* name, const void* buffer, s32 size, ImportParams params)
 {
-    onImportTilesBase(console, name, buffer, size, getBank(console, params.bank)->sprites.data, params);
+    onImportTilesBase(console, name, buffer, size, true, params);
 }
 
 static void onImport_map(Console* console, const char* name, const void* buffer, s32 size, ImportParams params)
@@ -1943,16 +2129,28 @@ static void onImport_screen(Console* console, const char* name, const void* buff
 
     if(img.data) SCOPE(free(img.data))
     {
-        if(img.width == TIC80_WIDTH && img.height == TIC80_HEIGHT)
+        s32 frames = getImportFrames(img, params);
+
+        if(frames && img.width == TIC80_WIDTH && img.height == TIC80_HEIGHT * frames)
         {
-            tic_bank* bank = getBank(console, params.bank);
             const tic_palette* pal = getPalette(console, params.bank, params.vbank);
+            u8* colors = quantizeImage(img, pal->colors, TIC_PALETTE_SIZE, params.dither);
 
-            s32 i = 0;
-            for(const png_rgba *pix = img.pixels, *end = pix + (TIC80_WIDTH * TIC80_HEIGHT); pix < end; pix++)
-                tic_tool_poke4(bank->screen.data, i++, tic_nearest_color(pal->colors, (tic_rgb*)pix, TIC_PALETTE_SIZE));
+            if(colors) SCOPE(free(colors))
+            {
+                enum {Size = TIC80_WIDTH * TIC80_HEIGHT};
 
-            error = false;
+                for(s32 frame = 0; frame < frames; frame++)
+                {
+                    tic_bank* bank = getBank(console, params.bank + frame);
+                    const u8* frameColors = colors + frame * Size;
+
+                    for(s32 i = 0; i < Size; i++)
+                        tic_tool_poke4(bank->screen.data, i, frameColors[i]);
+                }
+
+                error = false;
+            }
         }
     }
 
@@ -2067,49 +2265,170 @@ static void exportSprites(Console* console, const char* filename, tic_tile* base
     }
 }
 
-static void* embedCart(Console* console, u8* app, s32* size)
+static bool appendZipChunk(void* data, const void* buffer, s32 size)
+{
+    png_buffer* zip = data;
+    u8* ptr = realloc(zip->data, zip->size + size);
+
+    if(!ptr)
+        return false;
+
+    memcpy(ptr + zip->size, buffer, size);
+    zip->data = ptr;
+    zip->size += size;
+
+    return true;
+}
+
+typedef struct ExportJob ExportJob;
+
+// export writing on a worker thread, the cart is saved on the UI thread before it starts
+struct ExportJob
+{
+    Console* console;
+    bool(*write)(ExportJob* job);
+
+    char filename[TICNAME_MAX];
+    char path[TICNAME_MAX];
+
+    png_buffer player;
+    png_buffer cart;
+
+    tic_thread* thread;
+    tic_mutex* lock;
+    bool done;
+    bool result;
+};
+
+static void freeExportJob(ExportJob* job)
+{
+    if(job->lock)
+        tic_mutex_free(job->lock);
+
+    free(job->player.data);
+    free(job->cart.data);
+    free(job);
+}
+
+static s32 exportThread(void* data)
+{
+    ExportJob* job = data;
+    bool result = job->write(job);
+
+    tic_mutex_lock(job->lock);
+    job->result = result;
+    job->done = true;
+    tic_mutex_unlock(job->lock);
+
+    return 0;
+}
+
+static void checkExportJob(Console* console)
+{
+    ExportJob* job = console->exportJob;
+
+    if(!job)
+        return;
+
+    tic_mutex_lock(job->lock);
+    bool done = job->done;
+    tic_mutex_unlock(job->lock);
+
+    if(done)
+    {
+        tic_thread_join(job->thread);
+        console->exportJob = NULL;
+
+        onFileExported(console, job->filename, job->result);
+        freeExportJob(job);
+    }
+}
+
+static void startExportJob(Console* console, const char* filename, const net_get_data* data, bool(*write)(ExportJob*))
 {
     tic_mem* tic = console->tic;
-    u8* data = NULL;
-    void* cart = newCart();
 
-    SCOPE(free(cart))
+    // one export at a time, the running job owns console->exportJob
+    if(console->exportJob)
     {
-        s32 cartSize = tic_cart_save(&tic->cart, cart);
+        onFileExported(console, filename, false);
+        return;
+    }
 
-        s32 zipSize = sizeof(tic_cartridge);
-        u8* zipData = (u8*)malloc(zipSize);
+    ExportJob* job = calloc(1, sizeof(ExportJob));
 
-        SCOPE(free(zipData))
+    if(job)
+    {
+        *job = (ExportJob)
         {
-            if((zipSize = tic_tool_zip(zipData, zipSize, cart, cartSize)))
-            {
-                s32 appSize = *size;
+            .console = console,
+            .write = write,
+            .player = png_create(data->done.size),
+            .cart = png_create(sizeof(tic_cartridge)),
+        };
 
-                EmbedHeader header =
-                {
-                    .appSize = appSize,
-                    .cartSize = zipSize,
-                };
+        snprintf(job->filename, sizeof job->filename, "%s", filename);
+        snprintf(job->path, sizeof job->path, "%s", tic_fs_path(console->fs, filename));
+    }
 
-                memcpy(header.sig, CART_SIG, STRLEN(CART_SIG));
+    if(!job || !job->player.data || !job->cart.data)
+    {
+        if(job)
+            freeExportJob(job);
 
-                s32 finalSize = appSize + sizeof header + header.cartSize;
-                data = malloc(finalSize);
+        onFileExported(console, filename, false);
+        return;
+    }
 
-                if (data)
-                {
-                    memcpy(data, app, appSize);
-                    memcpy(data + appSize, &header, sizeof header);
-                    memcpy(data + appSize + sizeof header, zipData, header.cartSize);
+    memcpy(job->player.data, data->done.data, data->done.size);
+    job->cart.size = tic_cart_save(&tic->cart, job->cart.data);
+    job->lock = tic_mutex_create();
 
-                    *size = finalSize;
-                }
-            }
+    if(!job->lock || !(job->thread = tic_thread_create(exportThread, job)))
+    {
+        // no threads or no lock to hand the result back, write it right away
+        onFileExported(console, filename, write(job));
+        freeExportJob(job);
+        return;
+    }
+
+    console->exportJob = job;
+}
+
+static bool writeNativeExport(ExportJob* job)
+{
+    png_buffer zip = {NULL, 0};
+    bool result = false;
+
+    if(job->cart.size && tic_tool_zip_stream(job->cart.data, job->cart.size, tic_zip_best, appendZipChunk, &zip))
+    {
+        EmbedHeader header =
+        {
+            .appSize = job->player.size,
+            .cartSize = zip.size,
+        };
+
+        memcpy(header.sig, CART_SIG, STRLEN(CART_SIG));
+
+        s32 finalSize = job->player.size + sizeof header + header.cartSize;
+        u8* data = malloc(finalSize);
+
+        if (data)
+        {
+            memcpy(data, job->player.data, job->player.size);
+            memcpy(data + job->player.size, &header, sizeof header);
+            memcpy(data + job->player.size + sizeof header, zip.data, header.cartSize);
+
+            result = fs_write(job->path, data, finalSize);
+            chmod(job->path, DEFAULT_CHMOD);
+
+            free(data);
         }
     }
 
-    return data;
+    free(zip.data);
+
+    return result;
 }
 
 typedef struct
@@ -2156,24 +2475,13 @@ static void onNativeExportGet(const net_get_data* data)
             GameExportData* exportData = (GameExportData*)data->calldata;
             Console* console = exportData->console;
 
-            tic_mem* tic = console->tic;
-
             char filename[TICNAME_MAX];
             strcpy(filename, exportData->filename);
             free(exportData);
 
-            s32 size = data->done.size;
-
             printLine(console);
 
-            const char* path = tic_fs_path(console->fs, filename);
-            void* buf = NULL;
-
-            onFileExported(console, filename, (buf = embedCart(console, data->done.data, &size)) && fs_write(path, buf, size));
-            chmod(path, DEFAULT_CHMOD);
-
-            if (buf)
-                free(buf);
+            startExportJob(console, filename, data, writeNativeExport);
         }
         break;
     default:
@@ -2204,6 +2512,26 @@ static inline void exportNativeGame(Console* console, const char* name, const ch
     exportGame(console, name, system, onNativeExportGet, params);
 }
 
+static bool writeHtmlExport(ExportJob* job)
+{
+    bool result = job->cart.size && fs_write(job->path, job->player.data, job->player.size);
+
+    if(result)
+    {
+        struct zip_t *zip = zip_open(job->path, ZIP_DEFAULT_COMPRESSION_LEVEL, 'a');
+
+        if(zip) SCOPE(zip_close(zip))
+        {
+            zip_entry_open(zip, "cart.tic");
+            zip_entry_write(zip, job->cart.data, job->cart.size);
+            zip_entry_close(zip);
+        }
+        else result = false;
+    }
+
+    return result;
+}
+
 static void onHtmlExportGet(const net_get_data* data)
 {
     switch(data->type)
@@ -2213,40 +2541,11 @@ static void onHtmlExportGet(const net_get_data* data)
             GameExportData* exportData = (GameExportData*)data->calldata;
             Console* console = exportData->console;
 
-            tic_mem* tic = console->tic;
-
             char filename[TICNAME_MAX];
             strcpy(filename, exportData->filename);
             free(exportData);
 
-            const char* zipPath = tic_fs_path(console->fs, filename);
-            bool errorOccurred = !fs_write(zipPath, data->done.data, data->done.size);
-
-            if(!errorOccurred)
-            {
-                struct zip_t *zip = zip_open(zipPath, ZIP_DEFAULT_COMPRESSION_LEVEL, 'a');
-
-                if(zip) SCOPE(zip_close(zip))
-                {
-                    void* cart = newCart();
-
-                    SCOPE(free(cart))
-                    {
-                        s32 cartSize = tic_cart_save(&tic->cart, cart);
-
-                        if(cartSize)
-                        {
-                            zip_entry_open(zip, "cart.tic");
-                            zip_entry_write(zip, cart, cartSize);
-                            zip_entry_close(zip);
-                        }
-                        else errorOccurred = true;
-                    }
-                }
-                else errorOccurred = true;
-            }
-
-            onFileExported(console, filename, !errorOccurred);
+            startExportJob(console, filename, data, writeHtmlExport);
         }
         break;
     default:
@@ -2388,15 +2687,26 @@ static void onExport_sfx(Console* console, const char* param, const char* name,
     onFileExported(console, filename, !error);
 }
 
+static void onMusicFileExported(void* data, const char* name)
+{
+    Console* console = data;
+
+    printLine(console);
+    printBack(console, name);
+    printBack(console, " exported :)");
+}
+
 static void onExport_music(Console* console, const char* type, const char* name, ExportParams params)
 {
     const char* filename = getFilename(name, ".wav");
-    bool error = true;
-
-    if(params.id >= 0 && params.id < MUSIC_TRACKS)
-        error = studioExportMusic(console->studio, params.id, params.bank, filename) == NULL;
 
-    onFileExported(console, filename, !error);
+    // id=-1 exports all the tracks, stems=1 exports every channel to its own file
+    if(params.id >= -1 && params.id < MUSIC_TRACKS
+        && studioExportMusic(console->studio, params.id, params.bank, params.stems, filename, onMusicFileExported, console))
+    {
+        commandDone(console);
+    }
+    else onFileExported(console, filename, false);
 }
 
 static void onExport_screen(Console* console, const char* param, const char* name, ExportParams params)
@@ -2429,6 +2739,13 @@ static void onExport_help(Console* console, const char* param, const char* name,
 
 static void onExportCommand(Console* console)
 {
+    if(console->exportJob)
+    {
+        printError(console, "\nerror: previous export is still in progress.");
+        commandDone(console);
+        return;
+    }
+
     if(console->desc->count > 1)
     {
         ExportParams params = {0};
@@ -2478,7 +2795,26 @@ static void drawShadowText(tic_mem* tic, const char* text, s32 x, s32 y, tic_col
 
 const char* readMetatag(const char* code, const char* tag, const char* comment);
 
-static CartSaveResult saveCartName(Console* console, const char* name)
+#if defined(TIC80_PRO)
+static bool writeProject(const void* buffer, s32 size, void* data)
+{
+    return fs_append(data, buffer, size);
+}
+
+static bool streamProject(Console* console, const char* name)
+{
+    fs_file* file = fs_replace(tic_fs_path(console->fs, name));
+
+    if(!file)
+        return false;
+
+    bool done = tic_project_write(name, &console->tic->cart, writeProject, file);
+
+    return fs_close(file) && done;
+}
+#endif
+
+static CartSaveResult saveCartName(Console* console, const char* name, tic_zip_level level)
 {
     tic_mem* tic = console->tic;
 
@@ -2571,12 +2907,15 @@ static CartSaveResult saveCartName(Console* console, const char* name)
                         free(img.data);
                     }
 
-                    png_buffer zip = png_create(sizeof(tic_cartridge));
+                    png_buffer zip = {NULL, 0};
 
                     {
                         png_buffer cart = png_create(sizeof(tic_cartridge));
                         cart.size = tic_cart_save(&tic->cart, cart.data);
-                        zip.size = tic_tool_zip(zip.data, zip.size, cart.data, cart.size);
+
+                        if(!tic_tool_zip_stream(cart.data, cart.size, level, appendZipChunk, &zip))
+                            zip.size = 0;
+
                         free(cart.data);
                     }
 
@@ -2590,7 +2929,13 @@ static CartSaveResult saveCartName(Console* console, const char* name)
 #if defined(TIC80_PRO)
                 else if(project_ext(name))
                 {
-                    size = tic_project_save(name, buffer, &tic->cart);
+                    // projects are streamed to the file, no whole cart buffer
+                    if(streamProject(console, name))
+                    {
+                        setCartName(console, name, tic_fs_path(console->fs, name));
+                        success = true;
+                        studioRomSaved(console->studio);
+                    }
                 }
 #endif
                 else
@@ -2612,7 +2957,7 @@ static CartSaveResult saveCartName(Console* console, const char* name)
     }
     else if (strlen(console->rom.name))
     {
-        return saveCartName(console, console->rom.name);
+        return saveCartName(console, console->rom.name, level);
     }
     else return CART_SAVE_MISSING_NAME;
 
@@ -2621,12 +2966,16 @@ static CartSaveResult saveCartName(Console* console, const char* name)
 
 static CartSaveResult saveCart(Console* console)
 {
-    return saveCartName(console, NULL);
+    return saveCartName(console, NULL, tic_zip_fast);
 }
 
 static void onSaveCommandConfirmed(Console* console)
 {
-    CartSaveResult rom = saveCartName(console, console->desc->count ? console->desc->params->key : NULL);
+    // 'save <cart> best' compresses png carts harder at the cost of a slower save
+    tic_zip_level level = console->desc->count > 1 && strcmp(console->desc->params[1].key, "best") == 0
+        ? tic_zip_best : tic_zip_fast;
+
+    CartSaveResult rom = saveCartName(console, console->desc->count ? console->desc->params->key : NULL, level);
 
     if(rom == CART_SAVE_OK)
     {
@@ -2936,8 +3285,9 @@ static const char HelpUsage[] = "help [<text>"
         NULL,                                                                           \
         "Save cartridge to the local filesystem (Hotkey: CTRL+S), use $LANG_EXTENSIONS$"\
         "cart extension to save it in text format (PRO feature).\n"                     \
-        "Use .png file extension to save it as a png cart.",                            \
-        "save <cart>",                                                                  \
+        "Use .png file extension to save it as a png cart, "                            \
+        "add 'best' to compress it harder.",                                            \
+        "save <cart> [best]",                                                           \
         onSaveCommand,                                                                  \
         tabCompleteFiles,                                                               \
         NULL)                                                                           \
@@ -3020,7 +3370,9 @@ static const char HelpUsage[] = "help [<text>"
         NULL,                                                                           \
         "Import code/sprites/map/... from an external file.\n"                          \
         "While importing images, colors are merged to the "                             \
-        "closest color of the palette.",                                                \
+        "closest color of the palette, dither=1 uses ordered dithering and "            \
+        "dither=2 error diffusion. An image with a vertical stack of frames=N "        \
+        "frames is imported to N banks starting from bank.",                           \
         "\nimport [" IMPORT_CMD_LIST(IMPORT_CMD_DEF) "] "                            \
         "<file> [" IMPORT_KEYS_LIST(IMPORT_KEYS_DEF) "]",                            \
         onImportCommand,                                                                \
@@ -3075,6 +3427,15 @@ static const char HelpUsage[] = "help [<text>"
         NULL,                                                                           \
         onGameMenuCommand,                                                              \
         NULL,                                                                           \
+        NULL)                                                                           \
+                                                                                        \
+    macro("fft",                                                                        \
+        NULL,                                                                           \
+        "Show FFT capture stats, overruns are dropped windows,\n"                       \
+        "underruns are frames without new samples.",                                    \
+        NULL,                                                                           \
+        onFftCommand,                                                                   \
+        NULL,                                                                           \
         NULL)                                                                           \
     ADDGET_FILE(macro)
 
@@ -3895,6 +4256,9 @@ static void processCommand(Console* console, const char* text)
             {
                 cmd->handler(console);
                 command = NULL;
+
+                // commands write into any part of the cart
+                studioCartDirty(console->studio, -1, -1);
                 break;
             }
 
@@ -4338,6 +4702,8 @@ static void tick(Console* console)
     processKeyboard(console);
     processGamepad(console);
 
+    checkExportJob(console);
+
     Start* start = getStartScreen(console->studio);
 
     if(console->tickCounter == 0)
@@ -4474,7 +4840,35 @@ void forceAutoSave(Console* console, const char* cart_name)
     char namepath[TICNAME_MAX];
     strcpy(namepath, "/downloads/");
     strcat(namepath, cart_name);
-    CartSaveResult rom = saveCartName(console, namepath);
+
+    CartSaveResult rom = CART_SAVE_ERROR;
+
+    bool encoded = tic_tool_has_ext(namepath, PngExt);
+#if defined(TIC80_PRO)
+    encoded = encoded || project_ext(namepath);
+#endif
+
+    if(encoded)
+        rom = saveCartName(console, namepath, tic_zip_fast);
+    else
+    {
+        // plain carts are written in the background, the UI doesn't wait for the disk
+        u8* buffer = malloc(sizeof(tic_cartridge));
+
+        if(buffer) SCOPE(free(buffer))
+        {
+            const char* name = getCartName(namepath);
+            s32 size = tic_cart_save(&console->tic->cart, buffer);
+
+            if(size)
+            {
+                fs_write_async(tic_fs_path(console->fs, name), buffer, size, NULL, NULL);
+                setCartName(console, name, tic_fs_path(console->fs, name));
+                studioRomSaved(console->studio);
+                rom = CART_SAVE_OK;
+            }
+        }
+    }
 
     if(rom == CART_SAVE_OK)
     {
@@ -4588,6 +4982,12 @@ void initConsole(Console* console, Studio* studio, tic_fs* fs, tic_net* net, Con
 
 void freeConsole(Console* console)
 {
+    if(console->exportJob)
+    {
+        tic_thread_join(console->exportJob->thread);
+        freeExportJob(console->exportJob);
+    }
+
     free(console->text);
     free(console->color);
 
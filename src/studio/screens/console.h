@@ -102,6 +102,9 @@ struct Console
 
     CommandDesc* desc;
 
+    // export compressing and writing on a worker thread
+    struct ExportJob* exportJob;
+
     void(*load)(Console*, const char* path);
     bool(*loadCart)(Console*, const char* path);
     void(*loadByHash)(Console*, const char* name, const char* hash, const char* section, fs_done_callback callback, void* data);
@@ -339,7 +339,9 @@ static void gameMenuHandler(void* data, s32 pos)
     StudioMainMenu* main = data;
     tic_mem* tic = main->tic;
     resumeGame(main->studio);
-    tic_get_script(tic)->callback.menu(tic, pos, NULL);
+
+    if(tic_script_callbacks(tic) & tic_script_menu)
+        tic_get_script(tic)->callback.menu(tic, pos, NULL);
 }
 
 #if defined(BUILD_EDITORS)
@@ -77,6 +77,107 @@ static const char* data2md5(const void* data, s32 length)
     return out;
 }
 
+typedef struct
+{
+    u8 data[16];
+} CodeDigest;
+
+static CodeDigest codeDigest(const char* tag, const void* code, s32 codeSize)
+{
+    MD5_CTX c;
+    MD5_Init(&c);
+
+    // a new build invalidates the entries of the previous one
+    MD5_Update(&c, TIC_VERSION, sizeof TIC_VERSION);
+    MD5_Update(&c, tag, strlen(tag) + 1);
+
+    for(const u8* ptr = code; codeSize > 0; codeSize -= 512, ptr += 512)
+        MD5_Update(&c, ptr, codeSize > 512 ? 512 : codeSize);
+
+    CodeDigest digest;
+    MD5_Final(digest.data, &c);
+
+    return digest;
+}
+
+// one entry per cart and runtime, the file starts with the digest of the
+// code it was compiled from, so new bytecode replaces the old one
+static const char* codeCachePath(Run* run, const char* tag)
+{
+    static char path[TICNAME_MAX];
+
+    const char* cart = run->tic->saveid;
+
+#if defined(BUILD_EDITORS)
+    if(!*cart)
+        cart = run->console->rom.path;
+#endif
+
+    MD5_CTX c;
+    MD5_Init(&c);
+    MD5_Update(&c, cart, strlen(cart) + 1);
+    MD5_Update(&c, tag, strlen(tag) + 1);
+
+    u8 digest[16];
+    MD5_Final(digest, &c);
+
+    char hash[33];
+    tic_tool_buf2str(digest, sizeof digest, hash, false);
+    snprintf(path, sizeof path, TIC_CACHE "%s.bin", hash);
+
+    return path;
+}
+
+static void* cacheLoad(void* data, const char* tag, const void* code, s32 codeSize, s32* size)
+{
+    Run* run = (Run*)data;
+
+    if(!getConfig(run->studio)->codeCache)
+        return NULL;
+
+    u8* buffer = tic_fs_loadroot(run->fs, codeCachePath(run, tag), size);
+
+    if(buffer)
+    {
+        CodeDigest digest = codeDigest(tag, code, codeSize);
+
+        if(*size > sizeof digest && memcmp(buffer, &digest, sizeof digest) == 0)
+        {
+            *size -= sizeof digest;
+            memmove(buffer, buffer + sizeof digest, *size);
+            return buffer;
+        }
+
+        free(buffer);
+    }
+
+    return NULL;
+}
+
+static void cacheStore(void* data, const char* tag, const void* code, s32 codeSize, const void* buffer, s32 size)
+{
+    Run* run = (Run*)data;
+
+    if(!getConfig(run->studio)->codeCache)
+        return;
+
+    CodeDigest digest = codeDigest(tag, code, codeSize);
+    u8* entry = malloc(sizeof digest + size);
+
+    if(entry) SCOPE(free(entry))
+    {
+        memcpy(entry, &digest, sizeof digest);
+        memcpy(entry + sizeof digest, buffer, size);
+        fs_write_async(tic_fs_pathroot(run->fs, codeCachePath(run, tag)), entry, sizeof digest + size, NULL, NULL);
+    }
+}
+
+static void onSync(void* data, u32 mask, s32 bank)
+{
+    Run* run = (Run*)data;
+    studioCartDirty(run->studio, mask, bank);
+}
+
 static void initPMemName(Run* run)
 {
     tic_mem* tic = run->tic;
@@ -109,7 +210,7 @@ static void tick(Run* run)
 
     if(memcmp(run->pmem.data, tic->ram->persistent.data, Size))
     {
-        tic_fs_saveroot(run->fs, run->saveid, &tic->ram->persistent, Size, true);
+        fs_write_async(tic_fs_pathroot(run->fs, run->saveid), &tic->ram->persistent, Size, NULL, NULL);
         memcpy(run->pmem.data, tic->ram->persistent.data, Size);
     }
 
@@ -123,12 +224,20 @@ static void tick(Run* run)
 
 static u64 getFreq(void* data)
 {
-    return tic_sys_freq_get();
+    Run* run = (Run*)data;
+    return getStudioFreq(run->studio);
 }
 
 static u64 getCounter(void* data)
 {
-    return tic_sys_counter_get();
+    Run* run = (Run*)data;
+    return getStudioCounter(run->studio);
+}
+
+static s32 getTimestamp(void* data)
+{
+    Run* run = (Run*)data;
+    return getStudioTimestamp(run->studio);
 }
 
 void initRun(Run* run, Console* console, tic_fs* fs, Studio* studio)
@@ -148,7 +257,11 @@ void initRun(Run* run, Console* console, tic_fs* fs, Studio* studio)
             .exit = onExit,
             .data = run,
             .counter = getCounter,
-            .freq = getFreq
+            .freq = getFreq,
+            .tstamp = getTimestamp,
+            .cacheLoad = cacheLoad,
+            .cacheStore = cacheStore,
+            .sync = onSync,
         },
     };
 
@@ -331,7 +331,10 @@ static void coverLoaded(const net_get_data* netData)
 
     if (netData->type == net_get_done)
     {
-        tic_fs_saveroot(surf->fs, coverLoadingData->cachePath, netData->done.data, netData->done.size, false);
+        const char* path = tic_fs_pathroot(surf->fs, coverLoadingData->cachePath);
+
+        if(!fs_exists(path))
+            fs_write_async(path, netData->done.data, netData->done.size, NULL, NULL);
 
         char dir[TICNAME_MAX];
         tic_fs_dir(surf->fs, dir);
@@ -389,10 +392,9 @@ static void loadCover(Surf* surf)
     if(!tic_fs_ispubdir(surf->fs))
     {
 
-        s32 size = 0;
-        void* data = tic_fs_load(surf->fs, item->name, &size);
+        fs_mapping file;
 
-        if(data)
+        if(tic_fs_map(surf->fs, item->name, &file))
         {
             tic_cartridge* cart = (tic_cartridge*)malloc(sizeof(tic_cartridge));
 
@@ -401,7 +403,7 @@ static void loadCover(Surf* surf)
 
                 if(tic_tool_has_ext(item->name, PngExt))
                 {
-                    tic_cartridge* pngcart = loadPngCart((png_buffer){data, size});
+                    tic_cartridge* pngcart = loadPngCart((png_buffer){(u8*)file.data, file.size});
 
                     if(pngcart)
                     {
@@ -412,10 +414,10 @@ static void loadCover(Surf* surf)
                 }
 #if defined(TIC80_PRO)
                 else if(project_ext(item->name))
-                    tic_project_load(item->name, data, size, cart);
+                    tic_project_load(item->name, (const char*)file.data, file.size, cart);
 #endif
                 else
-                    tic_cart_load(cart, data, size);
+                    tic_cart_load(cart, file.data, file.size);
 
                 if(!EMPTY(cart->bank0.screen.data) && !EMPTY(cart->bank0.palette.vbank0.data))
                 {
@@ -426,7 +428,7 @@ static void loadCover(Surf* surf)
                 free(cart);
             }
 
-            free(data);
+            fs_unmap(&file);
         }
     }
     else if(item->hash && !item->cover)
@@ -605,18 +607,19 @@ static void loadCart(Surf* surf)
 
     if(tic_tool_has_ext(item->name, PngExt))
     {
-        s32 size = 0;
-        void* data = tic_fs_load(surf->fs, item->name, &size);
+        fs_mapping file;
 
-        if(data)
+        if(tic_fs_map(surf->fs, item->name, &file))
         {
-            tic_cartridge* cart = loadPngCart((png_buffer){data, size});
+            tic_cartridge* cart = loadPngCart((png_buffer){(u8*)file.data, file.size});
 
             if(cart)
             {
                 surf->anim.movie = resetMovie(&surf->anim.play);
                 free(cart);
             }
+
+            fs_unmap(&file);
         }
     }
     else surf->anim.movie = resetMovie(&surf->anim.play);
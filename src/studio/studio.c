@@ -34,10 +34,9 @@
 #include "screens/surf.h"
 #include "ext/history.h"
 #include "net.h"
-#include "wave_writer.h"
+#include "wave.h"
 #include "ext/gif.h"
-#define MSF_GIF_IMPL
-#include "msf_gif.h"
+#include "ext/gifenc.h"
 
 #include "../fftdata.h"
 #include "ext/fft.h"
@@ -47,6 +46,9 @@
 #include "ext/md5.h"
 #include "config.h"
 #include "cart.h"
+#include "replay.h"
+#include "capture.h"
+#include "sink.h"
 #include "screens/start.h"
 #include "screens/run.h"
 #include "screens/menu.h"
@@ -74,11 +76,42 @@
 #endif
 
 #ifdef BUILD_EDITORS
+
+#define CART_SECTIONS_LIST(macro) \
+    macro(screen)   \
+    macro(tiles)    \
+    macro(sprites)  \
+    macro(map)      \
+    macro(sfx)      \
+    macro(music)    \
+    macro(flags)    \
+    macro(palette)
+
+// per-section hashes, the code and binary sections only cover the used size
 typedef struct
 {
-    u8 data[MD5_HASHSIZE];
+    u64 code;
+    u64 binary;
+    u8 lang;
+
+    struct
+    {
+#define CART_SECTION_DEF(name) u64 name;
+        CART_SECTIONS_LIST(CART_SECTION_DEF)
+#undef  CART_SECTION_DEF
+    } banks[TIC_BANKS];
 } CartHash;
 
+// code, binary and lang, a bank section uses its tic_sync_* bit
+#define CART_DIRTY_CODE (1u << 31)
+
+// sections written since their hashes were taken, clean sections are never rehashed
+typedef struct
+{
+    bool code;
+    u32 banks[TIC_BANKS];
+} CartDirty;
+
 static const EditorMode Modes[] =
 {
     TIC_CODE_MODE,
@@ -138,7 +171,9 @@ struct Studio
     struct
     {
         CartHash hash;
+        CartDirty dirty;
         u64 mdate;
+        fs_watch* watch;
     }cart;
 
     struct
@@ -190,10 +225,12 @@ struct Studio
         bool record;
         bool screenshot;
 
-        u32* buffer;
         s32 frame;
+        s32 time;
 
-        MsfGifState gif;
+        gif_encoder* gif;
+        fs_file* file;
+        char name[TICNAME_MAX];
 
     } video;
 
@@ -228,12 +265,40 @@ struct Studio
     s32 samplerate;
     tic_font systemFont;
 
+    struct
+    {
+        tic_replay* record;
+        tic_replay* play;
+        tic_replay_frame frame;
+        char* path;
+
+        struct
+        {
+            u64 total;
+            u64 min;
+            u64 max;
+        } time;
+    } replay;
+
+    struct
+    {
+        tic_capture* stream;
+        fs_file* file;
+    } capture;
+
+    struct
+    {
+        tic_sink* stream;
+        fs_file* file;
+    } sink;
+
 };
 
 #if defined(BUILD_EDITORS)
 
 static const char VideoGif[] = "video%i.gif";
 static const char ScreenGif[] = "screen%i.gif";
+static const char VideoCapture[] = "video%i.ticv";
 
 #endif
 
@@ -291,112 +356,106 @@ static const tic_music* getMusicSrc(Studio* studio)
 
 const char* studioExportSfx(Studio* studio, s32 index, const char* filename)
 {
-    tic_mem* tic = studio->tic;
-
     const char* path = tic_fs_path(studio->fs, filename);
 
-    if(wave_open( studio->samplerate, path ))
+    tic_wave wave =
     {
+        .sfx = getSfxSrc(studio),
+        .music = getMusicSrc(studio),
+        .track = -1,
+        .index = index,
+        .channels = (1 << TIC_SOUND_CHANNELS) - 1,
+        .path = path,
+    };
 
-#if TIC80_SAMPLE_CHANNELS == 2
-        wave_enable_stereo();
-#endif
-
-        const tic_sfx* sfx = getSfxSrc(studio);
-
-        sfx2ram(tic->ram, sfx);
-        music2ram(tic->ram, getMusicSrc(studio));
-
-        {
-            const tic_sample* effect = &sfx->samples.data[index];
-
-            enum{Channel = 0};
-            sfx_stop(tic, Channel);
-            tic_api_sfx(tic, index, effect->note, effect->octave, -1, Channel, MAX_VOLUME, MAX_VOLUME, SFX_DEF_SPEED);
-
-            for(s32 ticks = 0, pos = 0; pos < SFX_TICKS; pos = tic_tool_sfx_pos(effect->speed, ++ticks))
-            {
-                tic_core_tick_start(tic);
-                tic_core_tick_end(tic);
-                tic_core_synth_sound(tic);
-
-                wave_write(tic->product.samples.buffer, tic->product.samples.count);
-            }
-
-            sfx_stop(tic, Channel);
-            memset(tic->ram->registers, 0, sizeof(tic_sound_register));
-        }
-
-        wave_close();
-
-        return path;
-    }
-
-    return NULL;
+    return tic_wave_export(&wave, 1, studio->samplerate) ? path : NULL;
 }
 
-const char* studioExportMusic(Studio* studio, s32 track, s32 bank, const char* filename)
+static bool emptyTrack(const tic_track* track)
 {
-    tic_mem* tic = studio->tic;
+    for(s32 i = 0; i < COUNT_OF(track->data); i++)
+        if(track->data[i])
+            return false;
 
-    const char* path = tic_fs_path(studio->fs, filename);
+    return true;
+}
 
-    if(wave_open( studio->samplerate, path ))
-    {
-#if TIC80_SAMPLE_CHANNELS == 2
-        wave_enable_stereo();
-#endif
+bool studioExportMusic(Studio* studio, s32 track, s32 bank, bool stems, const char* filename, ExportedCallback callback, void* data)
+{
 #if defined(TIC80_PRO)
-        // chained = true in CLI. Set to false if want to use unchained
-        bool chained = studio->bank.chained;
-        if(chained)
-            memset(studio->bank.indexes, bank, sizeof studio->bank.indexes);
-        else
-            for(s32 i = 0; i < COUNT_OF(BankModes); i++)
-                if(BankModes[i] == TIC_MUSIC_MODE)
-                    studio->bank.indexes[i] = bank;
+    // chained = true in CLI. Set to false if want to use unchained
+    bool chained = studio->bank.chained;
+    if(chained)
+        memset(studio->bank.indexes, bank, sizeof studio->bank.indexes);
+    else
+        for(s32 i = 0; i < COUNT_OF(BankModes); i++)
+            if(BankModes[i] == TIC_MUSIC_MODE)
+                studio->bank.indexes[i] = bank;
 #endif
-        const tic_sfx* sfx = getSfxSrc(studio);
-        const tic_music* music = getMusicSrc(studio);
+    const tic_sfx* sfx = getSfxSrc(studio);
+    const tic_music* music = getMusicSrc(studio);
+    const Music* editor = studio->banks.music[bank];
 
-        sfx2ram(tic->ram, sfx);
-        music2ram(tic->ram, music);
+    u8 channels = 0;
+    for(s32 i = 0; i < TIC_SOUND_CHANNELS; i++)
+        if(editor->on[i])
+            channels |= 1 << i;
 
-        const tic_music_state* state = &tic->ram->music_state;
-        const Music* editor = studio->banks.music[bank];
+    // track < 0 exports all the tracks, stems put every channel to its own file
+    s32 first = track < 0 ? 0 : track;
+    s32 last = track < 0 ? MUSIC_TRACKS : track + 1;
+    s32 parts = stems ? TIC_SOUND_CHANNELS : 1;
 
-        tic_api_music(tic, track, -1, -1, false, editor->sustain, -1, -1);
+    tic_wave* waves = calloc((last - first) * parts, sizeof(tic_wave));
+    char (*paths)[TICNAME_MAX] = calloc((last - first) * parts, TICNAME_MAX);
+    char (*names)[TICNAME_MAX] = calloc((last - first) * parts, TICNAME_MAX);
+    s32 count = 0;
 
-        s32 frame = state->music.frame;
-        s32 frames = MUSIC_FRAMES * 16;
+    const char* ext = strrchr(filename, '.');
+    s32 len = ext ? ext - filename : strlen(filename);
+
+    for(s32 t = first; t < last; t++)
+    {
+        if(track < 0 && emptyTrack(&music->tracks.data[t]))
+            continue;
 
-        while(frames && state->flag.music_status == tic_music_play)
+        for(s32 c = 0; c < parts; c++, count++)
         {
-            tic_core_tick_start(tic);
+            char suffix[TICNAME_MAX] = "";
 
-            for (s32 i = 0; i < TIC_SOUND_CHANNELS; i++)
-                if(!editor->on[i])
-                    tic->ram->registers[i].volume = 0;
+            if(track < 0)
+                sprintf(suffix, "-%i", t);
 
-            tic_core_tick_end(tic);
-            tic_core_synth_sound(tic);
+            if(stems)
+                sprintf(suffix + strlen(suffix), "-ch%i", c);
 
-            wave_write(tic->product.samples.buffer, tic->product.samples.count);
+            snprintf(names[count], TICNAME_MAX, "%.*s%s%s", len, filename, suffix, ext ? ext : "");
+            strncpy(paths[count], tic_fs_path(studio->fs, names[count]), TICNAME_MAX - 1);
 
-            if(frame != state->music.frame)
+            waves[count] = (tic_wave)
             {
-                --frames;
-                frame = state->music.frame;
-            }
+                .sfx = sfx,
+                .music = music,
+                .track = t,
+                .sustain = editor->sustain,
+                .channels = stems ? channels & (1 << c) : channels,
+                .path = paths[count],
+            };
         }
+    }
 
-        tic_api_music(tic, -1, -1, -1, false, false, -1, -1);
+    bool done = count && tic_wave_export(waves, count, studio->samplerate);
 
-        wave_close();
-        return path;
-    }
+    // the tracks and stems go to their own files, so report the names actually written
+    if(done && callback)
+        for(s32 i = 0; i < count; i++)
+            callback(data, names[i]);
 
-    return NULL;
+    free(names);
+    free(paths);
+    free(waves);
+
+    return done;
 }
 #endif
 
@@ -577,8 +636,6 @@ void toClipboard(const void* data, s32 size, bool flip)
 
         if(clipboard)
         {
-            char* ptr = clipboard;
-
             tic_tool_buf2str(data, size, clipboard, flip);
             tic_sys_clipboard_set(clipboard);
             free(clipboard);
@@ -609,11 +666,12 @@ bool fromClipboard(void* data, s32 size, bool flip, bool remove_white_spaces, bo
             if (remove_white_spaces)
                 removeWhiteSpaces(clipboard);
 
+            s32 len = (s32)strlen(clipboard);
             bool valid = sameSize
-                ? strlen(clipboard) == size * 2
-                : strlen(clipboard) <= size * 2;
+                ? len == size * 2
+                : len <= size * 2;
 
-            if(valid) tic_tool_str2buf(clipboard, (s32)strlen(clipboard), data, flip);
+            if(valid) tic_tool_str2buf(clipboard, len, data, flip);
 
             return valid;
         }
@@ -1083,6 +1141,33 @@ void drawToolbar(Studio* studio, tic_mem* tic, bool bg)
     }
 }
 
+// the editors write into the cart through raw pointers all over the place,
+// so every section an editor can touch is marked on each of its ticks
+static void markEditorDirty(Studio* studio)
+{
+    switch(studio->mode)
+    {
+    case TIC_CODE_MODE:
+        studioCartDirty(studio, CART_DIRTY_CODE, 0);
+        break;
+    case TIC_SPRITE_MODE:
+        studioCartDirty(studio, tic_sync_tiles | tic_sync_sprites | tic_sync_flags | tic_sync_palette,
+            studio->bank.index.sprites);
+        break;
+    case TIC_MAP_MODE:
+    case TIC_WORLD_MODE:
+        studioCartDirty(studio, tic_sync_map, studio->bank.index.map);
+        break;
+    case TIC_SFX_MODE:
+        studioCartDirty(studio, tic_sync_sfx, studio->bank.index.sfx);
+        break;
+    case TIC_MUSIC_MODE:
+        studioCartDirty(studio, tic_sync_music, studio->bank.index.music);
+        break;
+    default: break;
+    }
+}
+
 void setStudioEvent(Studio* studio, StudioEvent event)
 {
     switch(studio->mode)
@@ -1119,6 +1204,8 @@ void setStudioEvent(Studio* studio, StudioEvent event)
         break;
     default: break;
     }
+
+    markEditorDirty(studio);
 }
 
 ClipboardEvent getClipboardEvent(Studio* studio)
@@ -1493,14 +1580,74 @@ static void initModules(Studio* studio)
     initWorldMap(studio);
 }
 
+static u64 hashData(const void* data, s32 size)
+{
+    const u8* ptr = data;
+    u64 hash = size * 0x9e3779b97f4a7c15ull;
+
+    // every step is a bijection of the state for a given word,
+    // so a change in a single word always changes the result
+    for(; size >= sizeof(u64); ptr += sizeof(u64), size -= sizeof(u64))
+    {
+        u64 word;
+        memcpy(&word, ptr, sizeof word);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+        hash ^= hash >> 32;
+    }
+
+    for(; size > 0; ptr++, size--)
+        hash = (hash ^ *ptr) * 0x100000001b3ull;
+
+    return hash ^ hash >> 29;
+}
+
+static u64 hashCode(const tic_cartridge* cart)
+{
+    const char* end = memchr(cart->code.data, '\0', sizeof cart->code.data);
+    return hashData(cart->code.data, end ? end - cart->code.data : sizeof cart->code.data);
+}
+
+static u64 hashBinary(const tic_cartridge* cart)
+{
+    return hashData(cart->binary.data, MIN(cart->binary.size, sizeof cart->binary.data));
+}
+
 static void updateHash(Studio* studio)
 {
-    md5(&studio->tic->cart, sizeof(tic_cartridge), studio->cart.hash.data);
+    const tic_cartridge* cart = &studio->tic->cart;
+    CartHash* hash = &studio->cart.hash;
+    CartDirty* dirty = &studio->cart.dirty;
+
+    if(dirty->code)
+    {
+        hash->code = hashCode(cart);
+        hash->binary = hashBinary(cart);
+        hash->lang = cart->lang;
+    }
+
+    for(s32 i = 0; i < TIC_BANKS; i++)
+    {
+        if(dirty->banks[i] == 0)
+            continue;
+
+#define CART_SECTION_DEF(name) if(dirty->banks[i] & tic_sync_##name) hash->banks[i].name = hashData(&cart->banks[i].name, sizeof cart->banks[i].name);
+        CART_SECTIONS_LIST(CART_SECTION_DEF)
+#undef  CART_SECTION_DEF
+    }
+
+    *dirty = (CartDirty){0};
 }
 
 static void updateMDate(Studio* studio)
 {
-    studio->cart.mdate = fs_date(studio->console->rom.path);
+    const char* path = studio->console->rom.path;
+
+    studio->cart.mdate = fs_date(path);
+
+    if(!studio->cart.watch)
+        studio->cart.watch = fs_watch_create();
+
+    fs_watch_file(studio->cart.watch, path, studio->config->data.watchInterval);
 }
 #endif
 
@@ -1565,33 +1712,70 @@ void studioRomLoaded(Studio* studio)
     initModules(studio);
 
     updateTitle(studio);
+    studioCartDirty(studio, -1, -1);
     updateHash(studio);
     updateMDate(studio);
 }
 
 bool studioCartChanged(Studio* studio)
 {
-    CartHash hash;
-    md5(&studio->tic->cart, sizeof(tic_cartridge), hash.data);
+    const tic_cartridge* cart = &studio->tic->cart;
+    const CartHash* hash = &studio->cart.hash;
+    CartDirty* dirty = &studio->cart.dirty;
 
-    return memcmp(hash.data, studio->cart.hash.data, sizeof(CartHash)) != 0;
+    // only the marked sections are rehashed, a section that matches its hash again
+    // is unmarked, so the next check doesn't hash it until it is written to
+    if(dirty->code)
+    {
+        if(cart->lang != hash->lang
+            || hashCode(cart) != hash->code
+            || hashBinary(cart) != hash->binary)
+            return true;
+
+        dirty->code = false;
+    }
+
+    for(s32 i = 0; i < TIC_BANKS; i++)
+    {
+        if(dirty->banks[i] == 0)
+            continue;
+
+#define CART_SECTION_DEF(name)                                                                  \
+        if(dirty->banks[i] & tic_sync_##name)                                                   \
+        {                                                                                       \
+            if(hashData(&cart->banks[i].name, sizeof cart->banks[i].name) != hash->banks[i].name) \
+                return true;                                                                    \
+            dirty->banks[i] &= ~tic_sync_##name;                                                \
+        }
+        CART_SECTIONS_LIST(CART_SECTION_DEF)
+#undef  CART_SECTION_DEF
+    }
+
+    return false;
 }
 #endif
 
+void studioCartDirty(Studio* studio, u32 mask, s32 bank)
+{
+#if defined(BUILD_EDITORS)
+    CartDirty* dirty = &studio->cart.dirty;
+
+    if(mask & CART_DIRTY_CODE)
+        dirty->code = true;
+
+    for(s32 i = 0; i < TIC_BANKS; i++)
+        if(bank < 0 || bank == i)
+            dirty->banks[i] |= mask & ~CART_DIRTY_CODE;
+#endif
+}
+
 void runGame(Studio* studio)
 {
 #if defined(BUILD_EDITORS)
 
     if (studio->config->data.fft) {
         // initialize FFT data structures
-        fPeakMinValue = 0.01f;
-        fPeakSmoothing = 0.995f;
-        fPeakSmoothValue = 0.0f;
-        fAmplification = 1.0f;
-        memset(fftData, 0, sizeof(fftData[0]) * FFT_SIZE);
-        memset(fftSmoothingData, 0, sizeof(fftSmoothingData[0]) * FFT_SIZE);
-        memset(fftNormalizedData, 0, sizeof(fftNormalizedData[0]) * FFT_SIZE);
-        memset(fftNormalizedMaxData, 0, sizeof(fftNormalizedMaxData[0]) * FFT_SIZE);
+        FFT_ResetData();
     }
 
     if(studio->console->args.keepcmd
@@ -1663,55 +1847,104 @@ static void setCoverImage(Studio* studio)
     }
 }
 
-static void stopVideoRecord(Studio* studio, const char* name)
+static void stopVideoRecord(Studio* studio)
 {
-    MsfGifResult result = msf_gif_end(&studio->video.gif);
+    // waits for the queued frames to be encoded
+    bool done = gif_encoder_close(studio->video.gif);
+    done = fs_close(studio->video.file) && done;
 
-    // Find an available filename to save.
+    if(done)
+    {
+        char msg[TICNAME_MAX];
+        sprintf(msg, "%s saved :)", studio->video.name);
+        showPopupMessage(studio, msg);
+
+        tic_sys_open_path(tic_fs_path(studio->fs, studio->video.name));
+    }
+    else showPopupMessage(studio, "error: file not saved :(");
+
+    studio->video.gif = NULL;
+    studio->video.file = NULL;
+    studio->video.record = false;
+}
+
+static bool onVideoWrite(const void* buffer, s32 size, void* data)
+{
+    return fs_append(data, buffer, size);
+}
+
+static void findFilename(Studio* studio, const char* name, char* filename, s32 size)
+{
     s32 i = 0;
-    char filename[TICNAME_MAX];
     do
     {
-        snprintf(filename, sizeof filename, name, ++i);
+        snprintf(filename, size, name, ++i);
     }
     while(tic_fs_exists(studio->fs, filename));
+}
 
-    // Now that it has found an available filename, save it.
-    if(tic_fs_save(studio->fs, filename, result.data, result.dataSize, true))
-    {
-        char msg[TICNAME_MAX];
-        sprintf(msg, "%s saved :)", filename);
-        showPopupMessage(studio, msg);
+static bool startVideoRecord(Studio* studio, const char* name)
+{
+    // Find an available filename to save.
+    findFilename(studio, name, studio->video.name, sizeof studio->video.name);
 
-        tic_sys_open_path(tic_fs_path(studio->fs, filename));
+    // The file is written while recording, so long videos are not kept in memory.
+    if(!(studio->video.file = fs_create(tic_fs_path(studio->fs, studio->video.name))))
+    {
+        showPopupMessage(studio, "error: file not saved :(");
+        return false;
     }
-    else showPopupMessage(studio, "error: file not saved :(");
 
-    msf_gif_free(result);
+    studio->video.record = true;
+    studio->video.frame = 0;
+    studio->video.time = 0;
+    studio->video.gif = gif_encoder_create(TIC80_FULLWIDTH, TIC80_FULLHEIGHT,
+        studio->config->data.uiScale, onVideoWrite, studio->video.file);
 
-    studio->video.record = false;
+    return true;
 }
 
-static void startVideoRecord(Studio* studio)
+static bool startCapture(Studio* studio, const char* path);
+static bool stopCapture(Studio* studio);
+
+static void toggleCapture(Studio* studio)
 {
-    if(studio->video.record)
+    static char filename[TICNAME_MAX];
+
+    if(studio->capture.stream)
     {
-        stopVideoRecord(studio, VideoGif);
+        char msg[TICNAME_MAX];
+        if(stopCapture(studio))
+            snprintf(msg, sizeof msg, "%s saved :)", filename);
+        else
+            snprintf(msg, sizeof msg, "error: file not saved :(");
+
+        showPopupMessage(studio, msg);
     }
     else
     {
-        studio->video.record = true;
-        studio->video.frame = 0;
+        findFilename(studio, VideoCapture, filename, sizeof filename);
 
-        s32 scale = studio->config->data.uiScale;
-        msf_gif_begin(&studio->video.gif, TIC80_FULLWIDTH * scale, TIC80_FULLHEIGHT * scale);
+        if(startCapture(studio, tic_fs_path(studio->fs, filename)))
+            showPopupMessage(studio, "capture started...");
+        else showPopupMessage(studio, "error: file not saved :(");
     }
 }
 
+static void toggleVideoRecord(Studio* studio)
+{
+    if(studio->video.record)
+        stopVideoRecord(studio);
+    else
+        startVideoRecord(studio, VideoGif);
+}
+
 static void takeScreenshot(Studio* studio)
 {
-    startVideoRecord(studio);
-    studio->video.screenshot = true;
+    if(studio->video.record)
+        stopVideoRecord(studio);
+    else if(startVideoRecord(studio, ScreenGif))
+        studio->video.screenshot = true;
 }
 #endif
 
@@ -1917,7 +2150,10 @@ static void processShortcuts(Studio* studio)
             }
         }
         else if(keyWasPressedOnce(studio, tic_key_f8)) takeScreenshot(studio);
-        else if(keyWasPressedOnce(studio, tic_key_f9)) startVideoRecord(studio);
+        else if(keyWasPressedOnce(studio, tic_key_f9))
+            tic_api_key(tic, tic_key_shift)
+                ? toggleCapture(studio)
+                : toggleVideoRecord(studio);
         else if(keyWasPressedOnce(studio, tic_key_f10)) hideBattleTime(studio);
         else if(keyWasPressedOnce(studio, tic_key_f12)) startBattle(studio);
         else if(studio->mode == TIC_RUN_MODE && keyWasPressedOnce(studio, tic_key_f7))
@@ -1971,6 +2207,10 @@ static void checkChanges(Studio* studio)
         {
             Console* console = studio->console;
 
+            // the watcher reports changes of the file date without touching the disk every frame
+            if(!studio->cart.watch || !fs_watch_changed(studio->cart.watch))
+                break;
+
             u64 date = fs_date(console->rom.path);
 
             if(studio->cart.mdate && date > studio->cart.mdate)
@@ -2018,26 +2258,21 @@ static void recordFrame(Studio* studio, u32* pixels)
 {
     if(studio->video.record)
     {
+        // gif delays are in centiseconds, so every second frame is saved
+        // and the delays alternate between 3 and 4 to keep 30fps on average
         if(studio->video.frame % 2 == 0)
         {
-            s32 scale = studio->config->data.uiScale;
-            s32 w = TIC80_FULLWIDTH * scale;
-            s32 h = TIC80_FULLHEIGHT * scale;
-
-            u32 *ptr = studio->video.buffer;
-            const u32 *src = pixels;
-            for(s32 y = 0; y < h; y++, src = pixels + (y / scale) * TIC80_FULLWIDTH)
-                for(s32 x = 0; x < w; x++)
-                    *ptr++ = src[x / scale];
+            s32 time = (studio->video.frame + 2) * 100 / TIC80_FRAMERATE;
 
-            // with centiSecondsPerFame == 3 we have 1000/(3*10)=~33.3fps, so we have to save every second frame
-            msf_gif_frame(&studio->video.gif, (u8*)studio->video.buffer, 3, 16, w * sizeof(u32));
+            // only the native frame is copied here, scaling and encoding are done by the encoder thread
+            gif_encoder_frame(studio->video.gif, pixels, time - studio->video.time);
+            studio->video.time = time;
         }
 
         if(studio->video.screenshot)
         {
             studio->video.screenshot = false;
-            stopVideoRecord(studio, ScreenGif);
+            stopVideoRecord(studio);
             return;
         }
 
@@ -2152,6 +2387,10 @@ static void renderStudio(Studio* studio)
     default: break;
     }
 
+#if defined(BUILD_EDITORS)
+    markEditorDirty(studio);
+#endif
+
     tic_core_tick_end(tic);
 
     switch(studio->mode)
@@ -2212,9 +2451,6 @@ void studioConfigChanged(Studio* studio)
     Code* code = studio->code;
     if(code->update)
         code->update(code);
-
-    s32 scale = studio->config->data.uiScale;
-    studio->video.buffer = realloc(studio->video.buffer, TIC80_FULLWIDTH * scale * TIC80_FULLHEIGHT * scale * sizeof(u32));
 #endif
 
     updateSystemFont(studio);
@@ -2395,7 +2631,7 @@ const tic_mem* studio_mem(Studio* studio)
     return getMemory(studio);
 }
 
-void studio_tick(Studio* studio, tic80_input input)
+static void tickStudio(Studio* studio, tic80_input input)
 {
     tic_mem* tic = studio->tic;
     tic->ram->input = input;
@@ -2482,15 +2718,115 @@ void studio_tick(Studio* studio, tic80_input input)
         if(bb->exp)
             doCodeExport(studio);
         else if(bb->imp)
-            doCodeImport(studio);
+        {
+            if(!bb->watch)
+            {
+                bb->watch = fs_watch_create();
+                fs_watch_file(bb->watch, bb->imp, studio->config->data.watchInterval);
+                doCodeImport(studio);
+            }
+            else if(fs_watch_changed(bb->watch))
+                doCodeImport(studio);
+        }
 
         bb->ticks = 0;
     }
 #endif
 }
 
+u64 getStudioCounter(Studio* studio)
+{
+    return studio->replay.record || studio->replay.play
+        ? studio->replay.frame.time
+        : tic_sys_counter_get();
+}
+
+u64 getStudioFreq(Studio* studio)
+{
+    return studio->replay.record || studio->replay.play
+        ? TIC_REPLAY_FREQ
+        : tic_sys_freq_get();
+}
+
+s32 getStudioTimestamp(Studio* studio)
+{
+    return studio->replay.record || studio->replay.play
+        ? studio->replay.frame.tstamp
+        : (s32)time(NULL);
+}
+
+static void replayDone(Studio* studio)
+{
+    s32 frames = tic_replay_frames(studio->replay.play);
+    u64 freq = tic_sys_freq_get();
+
+    if(frames)
+        printf("replay: %i frames, avg %.3f ms, min %.3f ms, max %.3f ms\n", frames,
+            studio->replay.time.total * 1000.0 / freq / frames,
+            studio->replay.time.min * 1000.0 / freq,
+            studio->replay.time.max * 1000.0 / freq);
+
+    tic_replay_close(studio->replay.play);
+    studio->replay.play = NULL;
+
+    exitConfirm(studio, true, NULL);
+}
+
+static void replayTick(Studio* studio)
+{
+    if(!tic_replay_read(studio->replay.play, &studio->replay.frame))
+    {
+        replayDone(studio);
+        return;
+    }
+
+    u64 start = tic_sys_counter_get();
+    tickStudio(studio, studio->replay.frame.input);
+    u64 elapsed = tic_sys_counter_get() - start;
+
+    s32 frame = tic_replay_frames(studio->replay.play);
+    studio->replay.time.total += elapsed;
+    studio->replay.time.min = frame == 1 ? elapsed : MIN(studio->replay.time.min, elapsed);
+    studio->replay.time.max = MAX(studio->replay.time.max, elapsed);
+
+    printf("frame %i: %.3f ms\n", frame, elapsed * 1000.0 / tic_sys_freq_get());
+}
+
+static void sinkFrame(Studio* studio);
+
+void studio_tick(Studio* studio, tic80_input input)
+{
+    if(studio->replay.play)
+    {
+        replayTick(studio);
+    }
+    else
+    {
+        if(studio->replay.record)
+        {
+            studio->replay.frame = (tic_replay_frame)
+            {
+                .input = input,
+                .time = tic_replay_time(tic_sys_counter_get(), tic_sys_freq_get()),
+                .tstamp = (s32)time(NULL),
+            };
+
+            tic_replay_write(studio->replay.record, &studio->replay.frame);
+        }
+
+        tickStudio(studio, input);
+    }
+
+    if(studio->sink.stream)
+        sinkFrame(studio);
+}
+
 void studio_sound(Studio* studio)
 {
+    // the sink synthesizes the sound on every tick itself
+    if(studio->sink.stream)
+        return;
+
     tic_mem* tic = studio->tic;
     tic_core_synth_sound(tic);
 
@@ -2551,8 +2887,104 @@ void exitGame(Studio* studio)
     }
 }
 
+static bool onCaptureWrite(const void* buffer, s32 size, void* data)
+{
+    return fs_append(data, buffer, size);
+}
+
+static bool startCapture(Studio* studio, const char* path)
+{
+    if(!(studio->capture.file = fs_create(path)))
+        return false;
+
+    studio->capture.stream = tic_capture_create(studio->samplerate, onCaptureWrite, studio->capture.file);
+    tic_core_capture(studio->tic, studio->capture.stream);
+
+    return true;
+}
+
+static bool stopCapture(Studio* studio)
+{
+    tic_core_capture(studio->tic, NULL);
+
+    bool done = tic_capture_close(studio->capture.stream);
+    done = fs_close(studio->capture.file) && done;
+
+    studio->capture.stream = NULL;
+    studio->capture.file = NULL;
+
+    return done;
+}
+
+static bool onSinkWrite(const void* buffer, s32 size, void* data)
+{
+    return fs_append(data, buffer, size);
+}
+
+static bool startSink(Studio* studio, const char* path, const char* format, tic80_pixel_color_format pixels)
+{
+    if(!(studio->sink.file = strcmp(path, "-") == 0 ? fs_stdout() : fs_create(path)))
+        return false;
+
+    studio->sink.stream = tic_sink_create(format && strcmp(format, "indexed") == 0 ? tic_sink_indexed : tic_sink_rgba,
+        pixels, studio->samplerate, onSinkWrite, studio->sink.file);
+
+    return true;
+}
+
+static bool stopSink(Studio* studio)
+{
+    bool done = tic_sink_close(studio->sink.stream);
+    done = fs_close(studio->sink.file) && done;
+
+    studio->sink.stream = NULL;
+    studio->sink.file = NULL;
+
+    return done;
+}
+
+static void sinkFrame(Studio* studio)
+{
+    tic_mem* tic = studio->tic;
+    tic_core_synth_sound(tic);
+
+    // the reader has gone away, nothing to run for
+    if(!tic_sink_frame(studio->sink.stream, tic))
+    {
+        fprintf(stderr, "error: sink stream closed\n");
+        stopSink(studio);
+        exitConfirm(studio, true, NULL);
+    }
+}
+
+static void saveReplay(Studio* studio)
+{
+    s32 size = 0;
+    const u8* data = tic_replay_data(studio->replay.record, &size);
+
+    if(!fs_write(studio->replay.path, data, size))
+        fprintf(stderr, "error: replay `%s` not saved\n", studio->replay.path);
+}
+
 void studio_delete(Studio* studio)
 {
+    if(studio->replay.record)
+    {
+        saveReplay(studio);
+        tic_replay_close(studio->replay.record);
+    }
+
+    if(studio->replay.play)
+        tic_replay_close(studio->replay.play);
+
+    FREE(studio->replay.path);
+
+    if(studio->capture.stream && !stopCapture(studio))
+        fprintf(stderr, "error: capture not saved\n");
+
+    if(studio->sink.stream && !stopSink(studio))
+        fprintf(stderr, "error: sink not saved\n");
+
     {
 #if defined(BUILD_EDITORS)
         for(s32 i = 0; i < TIC_EDITOR_BANKS; i++)
@@ -2583,11 +3015,22 @@ void studio_delete(Studio* studio)
 
     tic_core_close(studio->tic);
 
+    // config, cache and save data may still be queued
+    fs_write_flush();
+
 #if defined(BUILD_EDITORS)
     tic_net_close(studio->net);
-    free(studio->video.buffer);
+
+    if(studio->video.record)
+    {
+        gif_encoder_close(studio->video.gif);
+        fs_close(studio->video.file);
+    }
+
     if(studio->bytebattle.exp) free(studio->bytebattle.exp);
     if(studio->bytebattle.imp) free(studio->bytebattle.imp);
+    if(studio->bytebattle.watch) fs_watch_free(studio->bytebattle.watch);
+    if(studio->cart.watch) fs_watch_free(studio->cart.watch);
 #endif
 
     free(studio->fs);
@@ -2826,6 +3269,7 @@ Studio* studio_create(s32 argc, char **argv, s32 samplerate, tic80_pixel_color_f
     studio->mainmenu = NULL;
     tic_fs_makedir(studio->fs, TIC_LOCAL);
     tic_fs_makedir(studio->fs, TIC_LOCAL_VERSION);
+    tic_fs_makedir(studio->fs, TIC_CACHE);
 
     initConfig(studio->config, studio, studio->fs);
 
@@ -2859,6 +3303,41 @@ Studio* studio_create(s32 argc, char **argv, s32 samplerate, tic80_pixel_color_f
     studio->config->data.soft               |= args.soft;
     studio->config->data.cli                |= args.cli;
 
+    if(args.replay)
+    {
+        s32 size = 0;
+        void* data = fs_read(args.replay, &size);
+
+        if(data) SCOPE(free(data))
+            studio->replay.play = tic_replay_load(data, size);
+
+        if(!studio->replay.play)
+        {
+            fprintf(stderr, "error: can't load replay `%s`\n", args.replay);
+            exit(1);
+        }
+    }
+    else if(args.record)
+    {
+        studio->replay.record = tic_replay_create();
+        studio->replay.path = strdup(args.record);
+    }
+
+    if(args.threads > 0)
+        tic_core_blit_threads(studio->tic, args.threads);
+
+    if(args.capture && !startCapture(studio, args.capture))
+    {
+        fprintf(stderr, "error: can't create capture `%s`\n", args.capture);
+        exit(1);
+    }
+
+    if(args.sink && !startSink(studio, args.sink, args.sinkfmt, format))
+    {
+        fprintf(stderr, "error: can't create sink `%s`\n", args.sink);
+        exit(1);
+    }
+
 #if defined(BUILD_EDITORS)
     if(args.codeexport)
         studio->bytebattle.exp = strdup(args.codeexport);
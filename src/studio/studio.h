@@ -83,6 +83,12 @@
     macro(cmd,          char*,  STRING,     "=<str>",   "run commands in the console")      \
     macro(keepcmd,      int,    BOOLEAN,    "",         "re-execute commands on every run") \
     macro(version,      int,    BOOLEAN,    "",         "print program version")            \
+    macro(record,       char*,  STRING,     "=<str>",   "record input to the replay file")  \
+    macro(replay,       char*,  STRING,     "=<str>",   "replay input from the file")       \
+    macro(capture,      char*,  STRING,     "=<str>",   "capture video and audio to the file") \
+    macro(threads,      s32,    INTEGER,    "=<int>",   "parallel blit worker threads")     \
+    macro(sink,         char*,  STRING,     "=<str>",   "stream raw video and audio, - for stdout") \
+    macro(sinkfmt,      char*,  STRING,     "=<str>",   "sink video format: rgba or indexed") \
     CRT_CMD_PARAM(macro)
 
 #define SHOW_TOOLTIP(STUDIO, FORMAT, ...)   \
@@ -259,6 +265,11 @@ void confirmDialog(Studio* studio, const char** text, s32 rows, ConfirmCallback
 void confirmLoadCart(Studio* studio, ConfirmCallback callback, void* data);
 
 bool studioCartChanged(Studio* studio);
+
+// marks cart sections as possibly changed since the last load or save, only
+// marked sections are rehashed; mask is a set of tic_sync_* sections,
+// bank -1 marks every bank and a mask of -1 marks the code too
+void studioCartDirty(Studio* studio, u32 mask, s32 bank);
 void playSystemSfx(Studio* studio, s32 id);
 
 void gotoMenu(Studio* studio);
@@ -285,11 +296,16 @@ const StudioConfig* getConfig(Studio* studio);
 struct Start* getStartScreen(Studio* studio);
 struct Sprite* getSpriteEditor(Studio* studio);
 
-const char* studioExportMusic(Studio* studio, s32 track, s32 bank, const char* filename);
+typedef void(*ExportedCallback)(void* data, const char* name);
+bool studioExportMusic(Studio* studio, s32 track, s32 bank, bool stems, const char* filename, ExportedCallback callback, void* data);
 const char* studioExportSfx(Studio* studio, s32 sfx, const char* filename);
 
 tic_mem* getMemory(Studio* studio);
 
+u64 getStudioCounter(Studio* studio);
+u64 getStudioFreq(Studio* studio);
+s32 getStudioTimestamp(Studio* studio);
+
 const char* md5str(const void* data, s32 length);
 void sfx_stop(tic_mem* tic, s32 channel);
 s32 calcWaveAnimation(tic_mem* tic, u32 index, s32 channel);
@@ -304,6 +320,7 @@ typedef struct
 {
     char* exp;
     char* imp;
+    struct fs_watch* watch;
 
     struct
     {
@@ -125,6 +125,7 @@ typedef struct
     bool cli;
     bool soft;
     bool trim;
+    bool codeCache;
 
     struct StudioOptions
     {
@@ -148,6 +149,7 @@ typedef struct
     const tic_cartridge* cart;
 
     s32 uiScale;
+    s32 watchInterval;
 
     int fft;
     int fftcaptureplaybackdevices;
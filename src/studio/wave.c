@@ -0,0 +1,189 @@
+// MIT License
+
+// Copyright (c) 2020 Vadim Grigoruk @nesbox // grigoruk@gmail.com
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "wave.h"
+#include "api.h"
+#include "tools.h"
+#include "ext/thread.h"
+#include "wave_writer.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct
+{
+    s16* data;
+    s32 count;
+    s32 capacity;
+} Samples;
+
+typedef struct
+{
+    const tic_wave* waves;
+    tic_mem** cores;
+    Samples* samples;
+} Batch;
+
+static bool writeSamples(Samples* samples, const s16* data, s32 count)
+{
+    if(samples->count + count > samples->capacity)
+    {
+        s32 capacity = MAX(samples->capacity * 2, samples->count + count);
+        s16* ptr = realloc(samples->data, capacity * sizeof(s16));
+
+        if(!ptr)
+            return false;
+
+        samples->data = ptr;
+        samples->capacity = capacity;
+    }
+
+    memcpy(samples->data + samples->count, data, count * sizeof(s16));
+    samples->count += count;
+
+    return true;
+}
+
+static bool tick(tic_mem* tic, const tic_wave* wave, Samples* samples)
+{
+    tic_core_tick_start(tic);
+
+    for (s32 i = 0; i < TIC_SOUND_CHANNELS; i++)
+        if(!(wave->channels & (1 << i)))
+            tic->ram->registers[i].volume = 0;
+
+    tic_core_tick_end(tic);
+    tic_core_synth_sound(tic);
+
+    return writeSamples(samples, tic->product.samples.buffer, tic->product.samples.count);
+}
+
+static bool renderSfx(tic_mem* tic, const tic_wave* wave, Samples* samples)
+{
+    const tic_sample* effect = &wave->sfx->samples.data[wave->index];
+
+    enum{Channel = 0};
+    tic_api_sfx(tic, wave->index, effect->note, effect->octave, -1, Channel, MAX_VOLUME, MAX_VOLUME, SFX_DEF_SPEED);
+
+    for(s32 ticks = 0, pos = 0; pos < SFX_TICKS; pos = tic_tool_sfx_pos(effect->speed, ++ticks))
+        if(!tick(tic, wave, samples))
+            return false;
+
+    return true;
+}
+
+static bool renderMusic(tic_mem* tic, const tic_wave* wave, Samples* samples)
+{
+    const tic_music_state* state = &tic->ram->music_state;
+
+    tic_api_music(tic, wave->track, -1, -1, false, wave->sustain, -1, -1);
+
+    s32 frame = state->music.frame;
+    s32 frames = MUSIC_FRAMES * 16;
+
+    while(frames && state->flag.music_status == tic_music_play)
+    {
+        if(!tick(tic, wave, samples))
+            return false;
+
+        if(frame != state->music.frame)
+        {
+            --frames;
+            frame = state->music.frame;
+        }
+    }
+
+    return true;
+}
+
+static void renderWave(s32 index, void* data)
+{
+    const Batch* batch = data;
+    const tic_wave* wave = &batch->waves[index];
+    Samples* samples = &batch->samples[index];
+    tic_mem* tic = batch->cores[index];
+
+    bool done = wave->track < 0
+        ? renderSfx(tic, wave, samples)
+        : renderMusic(tic, wave, samples);
+
+    if(!done)
+    {
+        free(samples->data);
+        *samples = (Samples){0};
+    }
+}
+
+bool tic_wave_export(const tic_wave* waves, s32 count, s32 samplerate)
+{
+    bool done = true;
+
+    tic_pool* pool = tic_pool_create(tic_thread_count() - 1);
+
+    // rendered waves are kept in memory until written,
+    // so render as many as there are threads at a time
+    s32 size = tic_pool_threads(pool) + 1;
+    Samples* samples = calloc(size, sizeof(Samples));
+    tic_mem** cores = calloc(size, sizeof(tic_mem*));
+
+    for(s32 first = 0; first < count; first += size)
+    {
+        Batch batch = {waves + first, cores, samples};
+        s32 batchSize = MIN(size, count - first);
+
+        // the cores are created here, core creation isn't thread safe
+        for(s32 i = 0; i < batchSize; i++)
+        {
+            tic_mem* tic = cores[i] = tic_core_create(samplerate, TIC80_PIXEL_COLOR_RGBA8888);
+
+            memcpy(&tic->ram->sfx, batch.waves[i].sfx, sizeof tic->ram->sfx);
+            memcpy(&tic->ram->music, batch.waves[i].music, sizeof tic->ram->music);
+        }
+
+        tic_pool_run(pool, batchSize, renderWave, &batch);
+
+        // the wave writer isn't reentrant, the files are written one by one
+        for(s32 i = 0; i < batchSize; i++)
+        {
+            tic_core_close(cores[i]);
+
+            if(samples[i].data && wave_open(samplerate, batch.waves[i].path))
+            {
+#if TIC80_SAMPLE_CHANNELS == 2
+                wave_enable_stereo();
+#endif
+                wave_write(samples[i].data, samples[i].count);
+                wave_close();
+            }
+            else done = false;
+
+            free(samples[i].data);
+            samples[i] = (Samples){0};
+        }
+    }
+
+    free(cores);
+    free(samples);
+    tic_pool_free(pool);
+
+    return done;
+}
@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "tic80.h"
+#include "core/core.h"
 #include "script.h"
 #include "tools.h"
 #include "cart.h"
@@ -28,6 +29,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #if defined(TIC_MODULE_EXT)
 #include <dlfcn.h>
@@ -101,9 +103,53 @@ TIC80_API void tic80_load(tic80* tic, void* cart, s32 size)
 #endif
 }
 
+static u64 onReplayCounter(void* data)
+{
+    tic_core* core = (tic_core*)data;
+    return core->replay.frame.time;
+}
+
+static u64 onReplayFreq(void* data)
+{
+    return TIC_REPLAY_FREQ;
+}
+
+static s32 onReplayTimestamp(void* data)
+{
+    tic_core* core = (tic_core*)data;
+    return core->replay.frame.tstamp;
+}
+
 TIC80_API void tic80_tick(tic80* tic, tic80_input input, CounterCallback counter, FreqCallback freq)
 {
     tic_mem* mem = (tic_mem*)tic;
+    tic_core* core = (tic_core*)tic;
+
+    if(core->replay.play)
+    {
+        if(tic_replay_read(core->replay.play, &core->replay.frame))
+            input = core->replay.frame.input;
+        else
+        {
+            tic_replay_close(core->replay.play);
+            core->replay.play = NULL;
+
+            u64 last = core->replay.frame.time, rate = freq(tic);
+            core->replay.start = counter(tic)
+                - (last / TIC_REPLAY_FREQ * rate + last % TIC_REPLAY_FREQ * rate / TIC_REPLAY_FREQ);
+        }
+    }
+    else if(core->replay.record)
+    {
+        core->replay.frame = (tic_replay_frame)
+        {
+            .input = input,
+            .time = tic_replay_time(counter(tic), freq(tic)),
+            .tstamp = (s32)time(NULL),
+        };
+
+        tic_replay_write(core->replay.record, &core->replay.frame);
+    }
 
     mem->ram->input = input;
 
@@ -113,17 +159,72 @@ TIC80_API void tic80_tick(tic80* tic, tic80_input input, CounterCallback counter
         .trace = onTrace,
         .exit = onExit,
         .data = tic,
-        .start = 0,
+        .start = core->replay.start,
         .counter = counter,
         .freq = freq
     };
 
+    // the clock is frozen to the recorded values to make the replay deterministic
+    if(core->replay.play || core->replay.record)
+    {
+        tickData.counter = onReplayCounter;
+        tickData.freq = onReplayFreq;
+        tickData.tstamp = onReplayTimestamp;
+    }
+
     tic_core_tick_start(mem);
     tic_core_tick(mem, &tickData);
     tic_core_tick_end(mem);
     tic_core_blit(mem);
 }
 
+TIC80_API void tic80_record(tic80* tic)
+{
+    tic_core* core = (tic_core*)tic;
+
+    if(core->replay.record)
+        tic_replay_close(core->replay.record);
+
+    core->replay.record = tic_replay_create();
+}
+
+TIC80_API void* tic80_record_end(tic80* tic, s32* size)
+{
+    tic_core* core = (tic_core*)tic;
+    void* data = NULL;
+    *size = 0;
+
+    if(core->replay.record)
+    {
+        const u8* buffer = tic_replay_data(core->replay.record, size);
+        data = memcpy(malloc(*size), buffer, *size);
+
+        tic_replay_close(core->replay.record);
+        core->replay.record = NULL;
+    }
+
+    return data;
+}
+
+TIC80_API bool tic80_replay(tic80* tic, const void* data, s32 size)
+{
+    tic_core* core = (tic_core*)tic;
+
+    if(core->replay.play)
+        tic_replay_close(core->replay.play);
+
+    core->replay.play = tic_replay_load(data, size);
+    core->replay.start = 0;
+
+    return core->replay.play != NULL;
+}
+
+TIC80_API bool tic80_replaying(tic80* tic)
+{
+    tic_core* core = (tic_core*)tic;
+    return core->replay.play != NULL;
+}
+
 TIC80_API void tic80_sound(tic80* tic)
 {
     tic_mem* mem = (tic_mem*)tic;
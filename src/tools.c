@@ -86,6 +86,36 @@ u32 tic_nearest_color(const tic_rgb* palette, const tic_rgb* color, s32 count)
     return nearest;
 }
 
+void tic_color_cache_init(tic_color_cache* cache, const tic_rgb* palette, s32 count)
+{
+    cache->palette = palette;
+    cache->count = count;
+    memset(cache->keys, 0, sizeof cache->keys);
+}
+
+u32 tic_color_cache_nearest(tic_color_cache* cache, const tic_rgb* color)
+{
+    enum {Mask = (1 << TIC_COLOR_CACHE_BITS) - 1, MaxProbes = 8};
+
+    // 0 marks an empty slot, so the key has a bit above the 24 bits of color
+    u32 key = color->r | color->g << 8 | color->b << 16 | 1 << 24;
+    u32 slot = (key * 2654435761u) >> (32 - TIC_COLOR_CACHE_BITS);
+
+    for(s32 i = 0; i < MaxProbes; i++, slot = (slot + 1) & Mask)
+    {
+        if(cache->keys[slot] == key)
+            return cache->colors[slot];
+
+        if(cache->keys[slot] == 0)
+        {
+            cache->keys[slot] = key;
+            return cache->colors[slot] = tic_nearest_color(cache->palette, color, cache->count);
+        }
+    }
+
+    return tic_nearest_color(cache->palette, color, cache->count);
+}
+
 tic_blitpal tic_tool_palette_blit(const tic_palette* srcpal, tic80_pixel_color_format fmt)
 {
     tic_blitpal pal;
@@ -171,34 +201,44 @@ bool tic_tool_noise(const tic_waveform* wave)
     return FLAT4(wave->data) && *wave->data % 0xff == 0;
 }
 
+static const char HexDigits[] = "0123456789abcdef";
+
+// digit value + 1, zero for anything that isn't a hex digit
+static const u8 HexValues[256] =
+{
+    ['0'] = 1, ['1'] = 2, ['2'] = 3, ['3'] = 4, ['4'] = 5,
+    ['5'] = 6, ['6'] = 7, ['7'] = 8, ['8'] = 9, ['9'] = 10,
+    ['a'] = 11, ['b'] = 12, ['c'] = 13, ['d'] = 14, ['e'] = 15, ['f'] = 16,
+    ['A'] = 11, ['B'] = 12, ['C'] = 13, ['D'] = 14, ['E'] = 15, ['F'] = 16,
+};
+
 void tic_tool_buf2str(const void* data, s32 size, char* str, bool flip)
 {
+    const u8* src = data;
+    const s32 hi = flip ? 1 : 0, lo = flip ? 0 : 1;
+
     for(s32 i = 0; i < size; i++, str += 2)
     {
-        sprintf(str, "%02x", ((u8*)data)[i]);
-        if(flip) SWAP(str[0], str[1], char);
+        str[hi] = HexDigits[src[i] >> 4];
+        str[lo] = HexDigits[src[i] & 0xf];
     }
+
+    *str = '\0';
 }
 
 void tic_tool_str2buf(const char* str, s32 size, void* buf, bool flip)
 {
-    char val[] = "0x00";
-    const char* ptr = str;
+    const u8* ptr = (const u8*)str;
+    const s32 hi = flip ? 1 : 0, lo = flip ? 0 : 1;
 
-    for(s32 i = 0; i < size/2; i++)
+    for(s32 i = 0; i < size/2; i++, ptr += 2)
     {
-        if(flip)
-        {
-            val[3] = *ptr++;
-            val[2] = *ptr++;
-        }
-        else
-        {
-            val[2] = *ptr++;
-            val[3] = *ptr++;
-        }
+        u8 h = HexValues[ptr[hi]], l = HexValues[ptr[lo]];
 
-        ((u8*)buf)[i] = (u8)strtol(val, NULL, 16);
+        // parse like strtol, stop at the first bad digit
+        ((u8*)buf)[i] = h
+            ? l ? ((h - 1) << 4) | (l - 1) : h - 1
+            : 0;
     }
 }
 
@@ -98,7 +98,17 @@ void    tic_tool_set_track_row_sfx(tic_track_row* row, s32 sfx);
 void    tic_tool_buf2str(const void* data, s32 size, char* str, bool flip);
 void    tic_tool_str2buf(const char* str, s32 size, void* buf, bool flip);
 
-u32     tic_tool_zip(void* dest, s32 destSize, const void* source, s32 size);
+typedef enum
+{
+    tic_zip_fast,   // interactive saves
+    tic_zip_best,   // exports and 'save <cart> best'
+} tic_zip_level;
+
+typedef bool(*tic_zip_output)(void* data, const void* buffer, s32 size);
+
+// deflates in chunks passed to `output` as they are ready, no output buffer of the whole size is needed,
+// returns the compressed size or 0 if deflate or `output` failed
+u32     tic_tool_zip_stream(const void* source, s32 size, tic_zip_level level, tic_zip_output output, void* data);
 u32     tic_tool_unzip(void* dest, s32 bufSize, const void* source, s32 size);
 
 bool    tic_tool_empty(const void* buffer, s32 size);
@@ -110,4 +120,20 @@ bool    tic_tool_flat4(const void* buffer, s32 size);
 bool    tic_tool_noise(const tic_waveform* wave);
 u32     tic_nearest_color(const tic_rgb* palette, const tic_rgb* color, s32 count);
 
+#define TIC_COLOR_CACHE_BITS 12
+
+// tic_nearest_color memo for converting whole images, exact colors are kept in a small open addressing table,
+// colors that don't fit are looked up every time
+typedef struct
+{
+    const tic_rgb* palette;
+    s32 count;
+
+    u32 keys[1 << TIC_COLOR_CACHE_BITS];
+    u8 colors[1 << TIC_COLOR_CACHE_BITS];
+} tic_color_cache;
+
+void    tic_color_cache_init(tic_color_cache* cache, const tic_rgb* palette, s32 count);
+u32     tic_color_cache_nearest(tic_color_cache* cache, const tic_rgb* color);
+
 const char* tic_tool_metatag(const char* code, const char* tag, const char* comment);
@@ -24,10 +24,44 @@
 
 #include <zlib.h>
 
-u32 tic_tool_zip(void* dest, s32 destSize, const void* source, s32 size)
+static inline s32 zipLevel(tic_zip_level level)
 {
-    unsigned long destSizeLong = destSize;
-    return compress2(dest, &destSizeLong, source, size, Z_BEST_COMPRESSION) == Z_OK ? destSizeLong : 0;
+    return level == tic_zip_fast ? Z_BEST_SPEED : Z_BEST_COMPRESSION;
+}
+
+u32 tic_tool_zip_stream(const void* source, s32 size, tic_zip_level level, tic_zip_output output, void* data)
+{
+    z_stream stream = {0};
+
+    if(deflateInit(&stream, zipLevel(level)) != Z_OK)
+        return 0;
+
+    stream.next_in = (Bytef*)source;
+    stream.avail_in = size;
+
+    u8 chunk[16 * 1024];
+    s32 status;
+
+    do
+    {
+        stream.next_out = chunk;
+        stream.avail_out = sizeof chunk;
+
+        status = deflate(&stream, Z_FINISH);
+
+        s32 done = sizeof chunk - stream.avail_out;
+        if(done && !output(data, chunk, done))
+            status = Z_STREAM_ERROR;
+
+        if(status == Z_STREAM_ERROR)
+            break;
+    }
+    while(status != Z_STREAM_END);
+
+    u32 total = status == Z_STREAM_END ? stream.total_out : 0;
+    deflateEnd(&stream);
+
+    return total;
 }
 
 u32 tic_tool_unzip(void* dest, s32 destSize, const void* source, s32 size)
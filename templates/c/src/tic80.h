@@ -246,6 +246,10 @@ WASM_IMPORT("map")
 // Draw a map region.
 void map(int32_t x, int32_t y, int32_t w, int32_t h, int32_t sx, int32_t sy, uint8_t* trans_colors, int8_t colorCount, int8_t scale, int32_t remap);
 
+WASM_IMPORT("blit")
+// Draw a w*h block of pixels, one per byte or two per byte when packed.
+void blit(int32_t x, int32_t y, int32_t w, int32_t h, const uint8_t* data, int32_t size, bool packed);
+
 WASM_IMPORT("pix")
 // Get or set the color of a single pixel.
 uint8_t pix(int32_t x, int32_t y, int8_t color);
@@ -354,6 +358,10 @@ WASM_IMPORT("poke4")
 // Write a nibble value to an address in RAM.
 void poke4(int32_t address, int8_t value);
 
+WASM_IMPORT("memput")
+// Copy a buffer from anywhere in WASM memory into RAM.
+void memput(int32_t address, const uint8_t* data, int32_t size);
+
 WASM_IMPORT("sync")
 // Copy banks of RAM (sprites, map, etc) to and from the cartridge.
 void sync(int32_t mask, int8_t bank, int8_t to_cart);
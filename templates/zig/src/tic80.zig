@@ -128,6 +128,8 @@ pub const raw = struct {
     pub extern fn map(x: i32, y: i32, w: i32, h: i32, sx: i32, sy: i32, trans_colors: ?[*]const u8, color_count: i32, scale: i32, remap: ?*const RemapArgs) void;
     pub extern fn memcpy(to: u32, from: u32, length: u32) void;
     pub extern fn memset(addr: u32, value: u8, length: u32) void;
+    pub extern fn memput(addr: u32, data: [*]const u8, length: u32) void;
+    pub extern fn blit(x: i32, y: i32, w: i32, h: i32, data: [*]const u8, length: u32, packed: bool) void;
     pub extern fn mget(x: i32, y: i32) i32;
     pub extern fn mouse(data: *MouseData) void;
     pub extern fn mset(x: i32, y: i32, tile_id: u32) void;
@@ -433,6 +435,14 @@ pub fn pmemget(index: u32) u32 {
 pub const memcpy = raw.memcpy;
 pub const memset = raw.memset;
 
+pub fn memput(addr: u32, data: []const u8) void {
+    raw.memput(addr, data.ptr, @intCast(data.len));
+}
+
+pub fn blit(x: i32, y: i32, w: i32, h: i32, data: []const u8, packed: bool) void {
+    raw.blit(x, y, w, h, data.ptr, @intCast(data.len), packed);
+}
+
 pub fn poke(addr: u32, value: u8) void {
     raw.poke(addr, value, 8);
 }